@@ -0,0 +1,325 @@
+#include <algorithm>
+#include <chrono>  // NOLINT [build/c++11]
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <random>
+#include <set>
+#include <stack>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ALT.h"
+#include "AStar.h"
+#include "BidirectionalAStar.h"
+#include "BreadthFirstSearch.h"
+#include "ContractionHierarchySearch.h"
+#include "DepthFirstSearch.h"
+#include "Dijkstra.h"
+#include "OBJParser.h"
+
+using routing::Graph;
+using routing::GraphNode;
+using routing::RoutingStrategy;
+
+namespace {
+// The searches as they were before SearchWorkspace and the CSR layout, kept as
+// a baseline. They still copy nodes and recompute edge lengths per edge.
+std::optional<std::vector<int>> tracePath(std::map<int, int> &parents, int end) {
+	auto n = end;
+	auto path = std::vector<int>();
+	while (n != -1) {
+		path.push_back(n);
+		if (!parents.contains(n)) return std::nullopt;
+		n = parents[n];
+	}
+	std::reverse(path.begin(), path.end());
+	return path;
+}
+
+class LegacyAStar : public RoutingStrategy {
+   public:
+	explicit LegacyAStar(bool useHeuristic) : useHeuristic(useHeuristic) {
+	}
+	std::optional<std::vector<int>> getPath(const Graph &g, int start, int end) const {
+		struct t {
+			double order;
+			struct {
+				int node;
+				int parent;
+				double distance;
+			} info;
+			bool operator<(const t &o) const {
+				return order > o.order;
+			}
+		};
+		auto q = std::priority_queue<t>();
+		auto v = std::set<int>();
+		auto parents = std::map<int, int>();
+		q.push({0, {start, -1, 0}});
+		while (!q.empty()) {
+			auto [n, p, d] = q.top().info;
+			q.pop();
+			if (v.contains(n)) continue;
+			v.insert(n);
+			parents[n] = p;
+			if (n == end) break;
+			GraphNode n1 = g.nodes[n];
+			for (int e = g.offsets[n]; e < g.offsets[n + 1]; e++) {
+				int o = g.neighbors[e];
+				GraphNode n2 = g.nodes[o];
+				auto dist = n1.getPosition().dist(n2.getPosition());
+				double h = useHeuristic ? n2.getPosition().dist(g.nodes[end].getPosition()) : 0;
+				q.push({d + dist + h, {o, n, d + dist}});
+			}
+		}
+		return tracePath(parents, end);
+	}
+
+   private:
+	bool useHeuristic;
+};
+
+template <typename Container>
+class LegacyUninformed : public RoutingStrategy {
+   public:
+	std::optional<std::vector<int>> getPath(const Graph &g, int start, int end) const {
+		auto c = Container();
+		auto v = std::set<int>();
+		auto parents = std::map<int, int>();
+		c.push({start, -1});
+		while (!c.empty()) {
+			auto [n, p] = next(c);
+			c.pop();
+			if (v.contains(n)) continue;
+			v.insert(n);
+			parents[n] = p;
+			if (n == end) break;
+			for (int e = g.offsets[n]; e < g.offsets[n + 1]; e++) c.push({g.neighbors[e], n});
+		}
+		return tracePath(parents, end);
+	}
+
+   private:
+	static std::pair<int, int> next(std::queue<std::pair<int, int>> &q) {
+		return q.front();
+	}
+	static std::pair<int, int> next(std::stack<std::pair<int, int>> &s) {
+		return s.top();
+	}
+};
+
+int linearNearestNode(const Graph &g, const Vector3 &pos) {
+	int min_i = -1;
+	double min_d = INFINITY;
+	for (int i = 0; i < g.nodes.size(); i++) {
+		double d = g.nodes[i].getPosition().dist(pos);
+		if (d < min_d) {
+			min_i = i;
+			min_d = d;
+		}
+	}
+	return min_i;
+}
+
+double tripsPerSecond(const Graph &g, const RoutingStrategy &strat,
+                      const std::vector<std::pair<Vector3, Vector3>> &trips) {
+	size_t checksum = 0;
+	auto begin = std::chrono::steady_clock::now();
+	for (auto &[s, e] : trips) {
+		auto path = g.getPath(s, e, strat);
+		if (path) checksum += path->size();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+	if (checksum == 1) std::cout << "";
+	return trips.size() / elapsed.count();
+}
+
+template <typename Snap>
+double snapsPerSecond(const std::vector<Vector3> &points, Snap snap) {
+	size_t checksum = 0;
+	auto begin = std::chrono::steady_clock::now();
+	for (auto &p : points) checksum += snap(p);
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+	if (checksum == 1) std::cout << "";
+	return points.size() / elapsed.count();
+}
+
+// Length of a path along the edges of g, or -1 if it uses an edge g does not have
+double pathCost(const Graph &g, const std::vector<int> &path) {
+	double cost = 0;
+	for (size_t i = 1; i < path.size(); i++) {
+		auto first = g.neighbors.begin() + g.offsets[path[i - 1]];
+		auto last = g.neighbors.begin() + g.offsets[path[i - 1] + 1];
+		auto e = std::find(first, last, path[i]);
+		if (e == last) return -1;
+		cost += g.edgeLengths[e - g.neighbors.begin()];
+	}
+	return cost;
+}
+
+// Runs the shortest path searches on g and compares their costs to the ones
+// in expected, -1 where there is no path. Returns the number of mismatches.
+int checkCosts(const std::string &label, const Graph &g, const std::vector<std::pair<int, int>> &queries,
+               const std::vector<double> &expected) {
+	routing::Dijkstra dijkstra;
+	routing::AStar astar;
+	routing::BidirectionalAStar bidastar;
+	routing::ALT alt;
+	routing::ContractionHierarchySearch ch;
+	std::vector<std::pair<std::string, const RoutingStrategy *>> searches = {
+	    {"dijkstra", &dijkstra}, {"astar", &astar}, {"bidastar", &bidastar}, {"alt", &alt}, {"ch", &ch}};
+	int mismatches = 0;
+	for (auto &[name, strat] : searches) {
+		for (size_t i = 0; i < queries.size(); i++) {
+			auto [s, e] = queries[i];
+			auto path = strat->getPath(g, s, e);
+			double cost = path ? pathCost(g, *path) : -1;
+			// Edge lengths are floats, equally short paths may differ in the last bits
+			if (std::abs(cost - expected[i]) <= 1e-4 * std::max(1.0, expected[i])) continue;
+			if (mismatches++ < 10) {
+				std::cout << label << " " << name << ": " << s << " -> " << e << " costs " << cost << ", expected "
+				          << expected[i] << std::endl;
+			}
+		}
+	}
+	return mismatches;
+}
+
+// Checks that the searches agree on path costs, both on a graph parsed from
+// file and on the same graph read back from its .graph and .ch caches.
+// Returns the number of mismatches.
+int checkSearches(const std::string &file, const std::vector<std::pair<int, int>> &queries) {
+	// Work on a copy so the caches are written fresh, whatever sits next to file
+	auto dir = std::filesystem::temp_directory_path() / ("routing_bench_" + std::to_string(std::random_device()()));
+	std::filesystem::create_directories(dir);
+	auto copy = (dir / "routes.obj").string();
+	std::filesystem::copy_file(file, copy);
+
+	const Graph *parsed = routing::OBJGraphParser(copy);
+	std::vector<double> expected;
+	routing::Dijkstra dijkstra;
+	for (auto [s, e] : queries) {
+		auto path = dijkstra.getPath(*parsed, s, e);
+		expected.push_back(path ? pathCost(*parsed, *path) : -1);
+	}
+	// The first CH search builds the hierarchy and writes the .ch cache
+	int mismatches = checkCosts("parsed", *parsed, queries, expected);
+	if (!std::filesystem::exists(copy + ".graph") || !std::filesystem::exists(copy + ".ch")) {
+		std::cout << "check: the .graph and .ch caches were not written" << std::endl;
+		mismatches++;
+	}
+	const Graph *cached = routing::OBJGraphParser(copy);
+	mismatches += checkCosts("cached", *cached, queries, expected);
+
+	delete parsed;
+	delete cached;
+	std::filesystem::remove_all(dir);
+	return mismatches;
+}
+
+double queriesPerSecond(const Graph &g, const RoutingStrategy &strat, const std::vector<std::pair<int, int>> &queries) {
+	size_t checksum = 0;
+	auto begin = std::chrono::steady_clock::now();
+	for (auto &[s, e] : queries) {
+		auto path = strat.getPath(g, s, e);
+		if (path) checksum += path->size();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+	// Keep the optimizer from dropping the searches
+	if (checksum == 1) std::cout << "";
+	return queries.size() / elapsed.count();
+}
+}  // namespace
+
+/// Compares routing query and nearest-node throughput of the current code against the
+/// original std::set/std::map searches and linear scan on a route graph. Fails without
+/// timing anything if the shortest path searches disagree on the cost of a route.
+int main(int argc, char **argv) {
+	std::string file = argc > 1 ? argv[1] : "web/public/assets/model/routes.obj";
+	int count = argc > 2 ? std::atoi(argv[2]) : 200;
+
+	const Graph *g = routing::OBJGraphParser(file);
+	if (!g || g->nodes.size() < 2) {
+		std::cout << "Usage: ./build/bin/routing_bench <routes.obj> [queries]" << std::endl;
+		delete g;
+		return 1;
+	}
+	std::cout << file << ": " << g->nodes.size() << " nodes, " << count << " queries" << std::endl;
+
+	std::mt19937 rng(3081);
+	std::uniform_int_distribution<int> pick(1, g->nodes.size() - 1);
+	std::vector<std::pair<int, int>> queries;
+	for (int i = 0; i < count; i++) queries.push_back({pick(rng), pick(rng)});
+
+	int mismatches = checkSearches(file, queries);
+	if (mismatches > 0) {
+		std::cout << mismatches << " routes differ in cost between the searches" << std::endl;
+		delete g;
+		return 1;
+	}
+	std::cout << "dijkstra, astar, bidastar, alt and ch agree on all routes, parsed and cached" << std::endl;
+	// Built on first use otherwise, which would be timed as part of the queries
+	g->getLandmarks();
+	g->getHierarchy();
+
+	struct Case {
+		std::string name;
+		const RoutingStrategy &before;
+		const RoutingStrategy &after;
+	};
+	LegacyAStar legacyAStar(true), legacyDijkstra(false);
+	LegacyUninformed<std::queue<std::pair<int, int>>> legacyBfs;
+	LegacyUninformed<std::stack<std::pair<int, int>>> legacyDfs;
+	routing::AStar astar;
+	routing::Dijkstra dijkstra;
+	routing::BreadthFirstSearch bfs;
+	routing::DepthFirstSearch dfs;
+	routing::BidirectionalAStar bidastar;
+	routing::ALT alt;
+	routing::ContractionHierarchySearch ch;
+	// The newer searches have no legacy version, so they are compared against the old A*
+	std::vector<Case> cases = {{"astar", legacyAStar, astar},       {"dijkstra", legacyDijkstra, dijkstra},
+	                           {"bfs", legacyBfs, bfs},             {"dfs", legacyDfs, dfs},
+	                           {"bidastar", legacyAStar, bidastar}, {"alt", legacyAStar, alt},
+	                           {"ch", legacyAStar, ch}};
+
+	std::cout << std::left << std::setw(10) << "search" << std::right << std::setw(14) << "before q/s"
+	          << std::setw(14) << "after q/s" << std::setw(10) << "speedup" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	for (auto &c : cases) {
+		double before = queriesPerSecond(*g, c.before, queries);
+		double after = queriesPerSecond(*g, c.after, queries);
+		std::cout << std::left << std::setw(10) << c.name << std::right << std::setw(14) << before << std::setw(14)
+		          << after << std::setw(9) << after / before << "x" << std::endl;
+	}
+
+	std::uniform_real_distribution<double> x(-1400, 1500), z(-800, 800);
+	std::vector<Vector3> points;
+	for (int i = 0; i < count * 10; i++) points.push_back({x(rng), 270, z(rng)});
+	double before = snapsPerSecond(points, [g](const Vector3 &p) { return linearNearestNode(*g, p); });
+	double after = snapsPerSecond(points, [g](const Vector3 &p) { return g->nearestNode(p); });
+	std::cout << std::left << std::setw(10) << "snap" << std::right << std::setw(14) << before << std::setw(14) << after
+	          << std::setw(9) << after / before << "x" << std::endl;
+
+	// Deliveries repeat between a handful of spots, so most trips hit the route cache
+	std::vector<Vector3> spots(points.begin(), points.begin() + 8);
+	std::uniform_int_distribution<int> spot(0, spots.size() - 1);
+	std::vector<std::pair<Vector3, Vector3>> trips;
+	for (int i = 0; i < count * 10; i++) trips.push_back({spots[spot(rng)], spots[spot(rng)]});
+	g->routeCache.setCapacity(0);
+	before = tripsPerSecond(*g, astar, trips);
+	g->routeCache.setCapacity(256);
+	g->routeCache.clear();
+	after = tripsPerSecond(*g, astar, trips);
+	std::cout << std::left << std::setw(10) << "cached" << std::right << std::setw(14) << before << std::setw(14)
+	          << after << std::setw(9) << after / before << "x  (" << g->routeCache.getHits() << " hits, "
+	          << g->routeCache.getMisses() << " misses)" << std::endl;
+
+	delete g;
+	return 0;
+}
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <chrono>  // NOLINT [build/c++11]
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT [build/c++11]
+#include <vector>
+
+#include "IController.h"
+#include "JobSystem.h"
+#include "SimulationModel.h"
+
+/// Controller without a view, it counts what the model reports and hashes
+/// every position it is sent, so runs can be checked for identical results
+class HeadlessController : public IController {
+   public:
+	void addEntity(const IEntity &entity) {
+		added++;
+	}
+
+	void updateEntity(const IEntity &entity) {
+		updates++;
+		Vector3 p = entity.getPosition();
+		for (double v : {p.x, p.y, p.z}) {
+			uint64_t bits;
+			std::memcpy(&bits, &v, sizeof(bits));
+			// FNV-1a
+			hash = (hash ^ bits) * 1099511628211ull;
+		}
+	}
+
+	void removeEntity(const IEntity &entity) {
+		removed++;
+	}
+
+	void sendEventToView(const std::string &event, const JsonObject &details) {
+		events++;
+	}
+
+	long added = 0;
+	long updates = 0;
+	long removed = 0;
+	long events = 0;
+	uint64_t hash = 14695981039346656037ull;
+};
+
+/// Creates a package and a robot at random spots and schedules a delivery between them
+void scheduleRandomTrip(SimulationModel &model, int i, std::mt19937 &rng) {
+	static const std::vector<std::string> strategies = {"astar", "dijkstra", "bfs", "dfs",
+	                                                    "bidastar", "alt", "ch", "beeline"};
+	std::uniform_real_distribution<double> x(-1400, 1500), z(-800, 800);
+	std::string name = "trip" + std::to_string(i);
+	JsonArray start = {x(rng), 254.665, z(rng)};
+	JsonArray end = {x(rng), 254.665, z(rng)};
+
+	JsonObject package;
+	package["type"] = "package";
+	package["name"] = name + "_package";
+	package["position"] = start;
+	package["direction"] = JsonArray({1, 0, 0});
+	package["speed"] = 30.0;
+	model.createEntity(package);
+
+	JsonObject robot;
+	robot["type"] = "robot";
+	robot["name"] = name;
+	robot["position"] = end;
+	robot["direction"] = JsonArray({1, 0, 0});
+	robot["speed"] = 30.0;
+	model.createEntity(robot);
+
+	JsonObject trip;
+	trip["name"] = name;
+	trip["start"] = JsonArray({start[0], start[2]});
+	trip["end"] = end;
+	trip["search"] = strategies[rng() % strategies.size()];
+	model.scheduleTrip(trip);
+}
+
+/// Runs a scene without a browser at a fixed time step, as fast as possible,
+/// and reports simulation throughput.
+int main(int argc, char **argv) {
+	if (argc < 2) {
+		std::cout << "Usage: ./build/bin/sim_headless <scene.json> [seconds] [dt] [trips] [threads]" << std::endl;
+		return 1;
+	}
+	std::string sceneFile = argv[1];
+	double seconds = argc > 2 ? std::atof(argv[2]) : 60;
+	double dt = argc > 3 ? std::atof(argv[3]) : 0.01;
+	// Random trips on top of the scene, only when asked for so a run replays the scene as written
+	int trips = argc > 4 ? std::atoi(argv[4]) : 0;
+	int threads = argc > 5 ? std::max(1, std::atoi(argv[5])) : std::thread::hardware_concurrency();
+
+	if (dt <= 0) {
+		std::cout << "dt must be positive" << std::endl;
+		return 1;
+	}
+
+	// Seed the entities' own randomness too, so runs are repeatable
+	std::srand(3081);
+	std::mt19937 rng(3081);
+	HeadlessController controller;
+	JobSystem jobs(threads);
+	SimulationModel model(controller, jobs);
+	// Runs are compared by their state hash, so routes must not depend on timing
+	model.setDeterministic(true);
+
+	auto loadStart = std::chrono::steady_clock::now();
+	// Scenes sit in the scenes directory of the web root their paths refer to
+	auto webRoot = std::filesystem::path(sceneFile).parent_path().parent_path();
+	if (!model.loadScene(sceneFile, webRoot.string())) return 1;
+	for (int i = 0; i < trips; i++) scheduleRandomTrip(model, i, rng);
+	std::chrono::duration<double> loadTime = std::chrono::steady_clock::now() - loadStart;
+
+	long ticks = seconds / dt;
+	long updatesBefore = controller.updates;
+	auto runStart = std::chrono::steady_clock::now();
+	for (long t = 0; t < ticks; t++) model.update(dt);
+	std::chrono::duration<double> runTime = std::chrono::steady_clock::now() - runStart;
+	long updates = controller.updates - updatesBefore;
+
+	std::cout << std::endl << "scene:               " << sceneFile << std::endl;
+	std::cout << "load time:           " << loadTime.count() << " s" << std::endl;
+	std::cout << "entities:            " << controller.added - controller.removed << std::endl;
+	std::cout << "simulated:           " << ticks * dt << " s in " << ticks << " ticks of " << dt << " s"
+	          << std::endl;
+	std::cout << "wall time:           " << runTime.count() << " s" << std::endl;
+	std::cout << "ticks/sec:           " << ticks / runTime.count() << std::endl;
+	std::cout << "entity-updates/sec:  " << updates / runTime.count() << std::endl;
+	std::cout << "threads:             " << threads << std::endl;
+	std::cout << "events sent:         " << controller.events << std::endl;
+	std::cout << "state hash:          " << std::hex << controller.hash << std::dec << std::endl;
+	return 0;
+}
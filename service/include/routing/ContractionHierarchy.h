@@ -0,0 +1,57 @@
+#ifndef CONTRACTION_HIERARCHY_H_
+#define CONTRACTION_HIERARCHY_H_
+
+#include <string>
+#include <vector>
+
+namespace routing {
+class Graph;
+/**
+ * @class ContractionHierarchy
+ * @brief Contraction hierarchy over an undirected Graph. Nodes are contracted
+ * in order of importance and shortcut edges keep shortest paths intact, so a
+ * query only has to search upward (towards higher rank) from both ends.
+ * Shortcuts remember the node they bypass so paths can be unpacked again.
+ */
+class ContractionHierarchy {
+   public:
+	struct Edge {
+		int target;
+		// Contracted node this shortcut bypasses, -1 for an original edge
+		int middle;
+		float weight;
+	};
+
+	ContractionHierarchy() {
+	}
+	/**
+	 * @brief Runs the preprocessing over the given (frozen) graph
+	 */
+	explicit ContractionHierarchy(const Graph &);
+	bool empty() const {
+		return rank.empty();
+	}
+	/**
+	 * @brief Writes the hierarchy to a cache file
+	 * @return Whether the file could be written
+	 */
+	bool save(const std::string &, const Graph &) const;
+	/**
+	 * @brief Reads a cache file written by save for the same graph
+	 * @return Whether a matching hierarchy was loaded
+	 */
+	bool load(const std::string &, const Graph &);
+	/**
+	 * @brief Appends the original nodes of the hierarchy edge a-b, excluding
+	 * a itself, to path
+	 */
+	void unpack(int a, int b, std::vector<int> &path) const;
+
+	std::vector<int> rank;
+	// Upward edges of node n are upEdges[upOffsets[n]] .. upEdges[upOffsets[n + 1] - 1]
+	std::vector<int> upOffsets;
+	std::vector<Edge> upEdges;
+};
+}  // namespace routing
+
+#endif  // CONTRACTION_HIERARCHY_H_
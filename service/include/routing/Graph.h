@@ -1,9 +1,16 @@
 #ifndef GRAPH_H_
 #define GRAPH_H_
 
+#include <mutex>
 #include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "ContractionHierarchy.h"
+#include "KdTree.h"
+#include "LandmarkTable.h"
+#include "RouteCache.h"
 #include "RoutingStrategy.h"
 #include "vector3.h"
 
@@ -19,21 +26,71 @@ class GraphNode {
 	int getID() const {
 		return id;
 	}
-	Vector3 getPosition() const {
+	const Vector3 &getPosition() const {
 		return position;
 	}
 };
 
 class Graph {
    public:
+	// Build-time adjacency, released by freeze()
 	std::vector<std::vector<int>> adjacencyList;
 	std::vector<GraphNode> nodes;
+
+	// Frozen compressed sparse row layout: the edges leaving node n are
+	// neighbors[offsets[n]] .. neighbors[offsets[n + 1] - 1], with their
+	// lengths at the same indices of edgeLengths.
+	std::vector<int> offsets;
+	std::vector<int> neighbors;
+	std::vector<float> edgeLengths;
+	std::vector<float> nodeX;
+	std::vector<float> nodeY;
+	std::vector<float> nodeZ;
+
+	// Spatial index over node positions, built by freeze()
+	KdTree spatialIndex;
+
+	// Landmark distances for ALT heuristics, built by buildLandmarks() or on
+	// first use by getLandmarks()
+	mutable LandmarkTable landmarks;
+	int landmarkCount = 8;
+
+	// Contraction hierarchy, built or loaded by buildHierarchy() or on first
+	// use by getHierarchy(), which caches it in hierarchyCache if set
+	mutable ContractionHierarchy hierarchy;
+	std::string hierarchyCache;
+
+	// Results of recent getPath() calls
+	mutable RouteCache routeCache;
+
 	Graph() {
 	}
 	void addNode(const Vector3 &);
 	void addEdge(int, int);
+	void freeze();
+	// Builds the frozen layout straight from directed (from, to) edges,
+	// keeping the edges of each node in the given order
+	void freeze(const std::vector<std::pair<int, int>> &);
+	// Fills the coordinate arrays and spatial index from nodes
+	void buildIndex();
+	void buildLandmarks(int);
+	void buildHierarchy(const std::string &);
+	// Build what only ALT and CH searches need the first time one asks,
+	// sessions that never use them never pay for it
+	const LandmarkTable &getLandmarks() const;
+	const ContractionHierarchy &getHierarchy() const;
+	bool isFrozen() const {
+		return offsets.size() == nodes.size() + 1;
+	}
+	float distance(int, int) const;
 	int nearestNode(const Vector3 &) const;
+	std::vector<int> nearestNodes(const Vector3 &, int) const;
+	std::vector<int> nodesWithin(const Vector3 &, double) const;
 	std::optional<std::vector<Vector3>> getPath(const Vector3 &, const Vector3 &, const RoutingStrategy &) const;
+
+   private:
+	mutable std::once_flag landmarksBuilt;
+	mutable std::once_flag hierarchyBuilt;
 };
 }  // namespace routing
 
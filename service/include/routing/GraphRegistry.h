@@ -0,0 +1,27 @@
+#ifndef GRAPH_REGISTRY_H_
+#define GRAPH_REGISTRY_H_
+
+#include <memory>
+#include <string>
+
+#include "Graph.h"
+
+namespace routing {
+/**
+ * @class GraphRegistry
+ * @brief Process-wide registry of parsed route graphs keyed by file path.
+ * Every session asking for the same file shares one read-only Graph, which
+ * is freed once the last session lets go of it. A file whose size or mtime
+ * changed is parsed again; sessions still holding the old graph keep it.
+ */
+class GraphRegistry {
+   public:
+	/**
+	 * @brief Returns the shared graph for an OBJ file, parsing it if needed
+	 * @return The graph, or nullptr if the file is not an OBJ file
+	 */
+	static std::shared_ptr<const Graph> acquire(const std::string &);
+};
+}  // namespace routing
+
+#endif  // GRAPH_REGISTRY_H_
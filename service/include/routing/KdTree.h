@@ -0,0 +1,50 @@
+#ifndef KD_TREE_H_
+#define KD_TREE_H_
+
+#include <array>
+#include <vector>
+
+#include "vector3.h"
+
+namespace routing {
+/**
+ * @class KdTree
+ * @brief Static 3-d tree over a set of points, stored implicitly as a
+ * median-split array. Answers nearest, k-nearest and radius queries in
+ * roughly logarithmic time instead of scanning every point.
+ */
+class KdTree {
+   public:
+	KdTree() {
+	}
+	/**
+	 * @brief Builds the tree over the given points. Query results are the
+	 * indices of the points in this vector.
+	 */
+	explicit KdTree(const std::vector<Vector3> &);
+	bool empty() const {
+		return ids.empty();
+	}
+	int nearest(const Vector3 &) const;
+	std::vector<int> nearest(const Vector3 &, int k) const;
+	std::vector<int> within(const Vector3 &, double radius) const;
+
+   private:
+	struct Candidate {
+		double d2;
+		int id;
+		bool operator<(const Candidate &o) const {
+			return d2 < o.d2 || (d2 == o.d2 && id < o.id);
+		}
+	};
+	void build(int lo, int hi, int axis);
+	double distance2(int i, const Vector3 &) const;
+	void nearest(int lo, int hi, int axis, const Vector3 &, Candidate &) const;
+	void nearest(int lo, int hi, int axis, const Vector3 &, int k, std::vector<Candidate> &) const;
+	void within(int lo, int hi, int axis, const Vector3 &, double r2, std::vector<int> &) const;
+	std::vector<std::array<double, 3>> points;
+	std::vector<int> ids;
+};
+}  // namespace routing
+
+#endif  // KD_TREE_H_
@@ -0,0 +1,35 @@
+#ifndef LANDMARK_TABLE_H_
+#define LANDMARK_TABLE_H_
+
+#include <vector>
+
+namespace routing {
+class Graph;
+/**
+ * @class LandmarkTable
+ * @brief Shortest-path distances from a few landmark nodes to every node,
+ * used for ALT lower bounds. By the triangle inequality
+ * |d(L, a) - d(L, b)| <= d(a, b) for every landmark L. Assumes an undirected
+ * graph, which is what OBJGraphParser produces.
+ */
+class LandmarkTable {
+   public:
+	LandmarkTable() {
+	}
+	/**
+	 * @brief Picks count landmarks by farthest-point selection and runs a
+	 * Dijkstra search from each of them.
+	 */
+	LandmarkTable(const Graph &, int count);
+	bool empty() const {
+		return landmarks.empty();
+	}
+	double lowerBound(int, int) const;
+
+	std::vector<int> landmarks;
+	// distances[n * landmarks.size() + l] is the distance from landmark l to n
+	std::vector<float> distances;
+};
+}  // namespace routing
+
+#endif  // LANDMARK_TABLE_H_
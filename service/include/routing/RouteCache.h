@@ -0,0 +1,70 @@
+#ifndef ROUTE_CACHE_H_
+#define ROUTE_CACHE_H_
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "vector3.h"
+
+namespace routing {
+/**
+ * @class RouteCache
+ * @brief Least recently used cache of routing results, keyed by the snapped
+ * start and end nodes and the type of the routing strategy. Failed searches
+ * are cached too. All operations are safe to call from several threads.
+ */
+class RouteCache {
+   public:
+	struct Key {
+		int start;
+		int end;
+		std::type_index strategy;
+		bool operator==(const Key &) const = default;
+	};
+	using Path = std::optional<std::vector<Vector3>>;
+
+	explicit RouteCache(size_t capacity = 256) : capacity(capacity) {
+	}
+	/**
+	 * @brief Looks up a route, marking it as most recently used
+	 * @return Whether the route was cached, in which case it is copied to path
+	 */
+	bool find(const Key &, Path &path);
+	void insert(const Key &, const Path &);
+	void clear();
+	/**
+	 * @brief Changes the number of routes kept, 0 disables the cache
+	 */
+	void setCapacity(size_t);
+	size_t size() const;
+	size_t getHits() const;
+	size_t getMisses() const;
+
+   private:
+	struct KeyHash {
+		size_t operator()(const Key &k) const {
+			size_t h = k.strategy.hash_code();
+			h = h * 31 + static_cast<unsigned>(k.start);
+			return h * 31 + static_cast<unsigned>(k.end);
+		}
+	};
+	using Entry = std::pair<Key, Path>;
+
+	void trim();
+
+	mutable std::mutex mutex;
+	size_t capacity;
+	// Most recently used first
+	std::list<Entry> entries;
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+	size_t hits = 0;
+	size_t misses = 0;
+};
+}  // namespace routing
+
+#endif  // ROUTE_CACHE_H_
@@ -0,0 +1,105 @@
+#ifndef SEARCH_WORKSPACE_H_
+#define SEARCH_WORKSPACE_H_
+
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace routing {
+/**
+ * @class SearchWorkspace
+ * @brief Flat-array scratch space shared by the graph searches. Visited flags
+ * and scores are generation stamped, so starting a new query is O(1) and no
+ * memory is allocated once the arrays have grown to the size of the graph.
+ */
+class SearchWorkspace {
+   public:
+	struct Entry {
+		double order;
+		int node;
+		int parent;
+		double distance;
+		bool operator<(const Entry &o) const {
+			return order > o.order;
+		}
+	};
+
+	/**
+	 * @class Lease
+	 * @brief Hands a workspace back to the calling thread's pool when it goes
+	 * out of scope.
+	 */
+	class Lease {
+	   public:
+		explicit Lease(std::unique_ptr<SearchWorkspace> ws) : ws(std::move(ws)) {
+		}
+		Lease(Lease &&) = default;
+		Lease(const Lease &) = delete;
+		Lease &operator=(const Lease &) = delete;
+		~Lease();
+		SearchWorkspace *operator->() const {
+			return ws.get();
+		}
+		SearchWorkspace &operator*() const {
+			return *ws;
+		}
+
+	   private:
+		std::unique_ptr<SearchWorkspace> ws;
+	};
+
+	/**
+	 * @brief Borrows a workspace from the per-thread pool, reset for a graph
+	 * with the given number of nodes.
+	 */
+	static Lease borrow(int size);
+
+	void reset(int size);
+
+	bool isVisited(int n) const {
+		return visitedStamp[n] == generation;
+	}
+
+	void visit(int n, int parent) {
+		visitedStamp[n] = generation;
+		parents[n] = parent;
+	}
+
+	double getScore(int n) const {
+		return scoreStamp[n] == generation ? scores[n] : INFINITY;
+	}
+
+	bool isReached(int n) const {
+		return scoreStamp[n] == generation;
+	}
+
+	/**
+	 * @brief Records a tentative score for n, reached from parent.
+	 */
+	void setScore(int n, double score, int parent) {
+		scoreStamp[n] = generation;
+		scores[n] = score;
+		parents[n] = parent;
+	}
+
+	/**
+	 * @brief Follows the parent links back from end.
+	 * @return The node path from the search root to end, or nullopt if end
+	 * was never reached.
+	 */
+	std::optional<std::vector<int>> tracePath(int end) const;
+
+	// Open set of the running search (heap, queue or stack)
+	std::vector<Entry> frontier;
+
+   private:
+	std::vector<unsigned> visitedStamp;
+	std::vector<unsigned> scoreStamp;
+	std::vector<int> parents;
+	std::vector<double> scores;
+	unsigned generation = 0;
+};
+}  // namespace routing
+
+#endif  // SEARCH_WORKSPACE_H_
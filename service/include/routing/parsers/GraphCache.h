@@ -0,0 +1,38 @@
+#ifndef GRAPH_CACHE_H_
+#define GRAPH_CACHE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "Graph.h"
+
+namespace routing {
+/**
+ * @brief Size and modification time of the file a graph was parsed from,
+ * stored in the cache to detect when it goes stale
+ */
+struct SourceStamp {
+	uint64_t size = 0;
+	int64_t mtime = 0;
+	bool operator==(const SourceStamp &) const = default;
+};
+
+SourceStamp sourceStamp(const std::string &);
+
+/**
+ * @brief Loads a frozen graph, with its landmarks if they were built, from a
+ * binary cache file
+ * @return The graph, or nullptr if the file is missing, malformed, refers to
+ * nodes or edges it does not have or was written for a different source
+ */
+Graph *readGraphCache(const std::string &, const SourceStamp &);
+
+/**
+ * @brief Writes a frozen graph, and its landmarks if they are built, to a
+ * binary cache file
+ * @return Whether the file could be written
+ */
+bool writeGraphCache(const Graph &, const std::string &, const SourceStamp &);
+}  // namespace routing
+
+#endif  // GRAPH_CACHE_H_
@@ -0,0 +1,37 @@
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace routing {
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file, unmapped on destruction.
+ */
+class MappedFile {
+   public:
+	explicit MappedFile(const std::string &);
+	~MappedFile();
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+	bool isOpen() const {
+		return data != nullptr;
+	}
+	const char *begin() const {
+		return data;
+	}
+	const char *end() const {
+		return data + length;
+	}
+	size_t size() const {
+		return length;
+	}
+
+   private:
+	const char *data = nullptr;
+	size_t length = 0;
+};
+}  // namespace routing
+
+#endif  // MAPPED_FILE_H_
@@ -0,0 +1,24 @@
+#ifndef ALT_H_
+#define ALT_H_
+
+#include <algorithm>
+
+#include "AStar.h"
+
+namespace routing {
+/**
+ * @class ALT
+ * @brief A* with landmark (ALT) lower bounds, falling back to the straight
+ * line distance wherever it is the tighter bound.
+ */
+class ALT : public AStar {
+   public:
+	ALT()
+	    : AStar([](const Graph &g, int n1, int n2) {
+		      return std::max<double>(g.distance(n1, n2), g.getLandmarks().lowerBound(n1, n2));
+	      }) {
+	}
+};
+}  // namespace routing
+
+#endif  // ALT_H_
@@ -9,11 +9,11 @@
 namespace routing {
 class AStar : public RoutingStrategy {
    protected:
-	std::function<double(const GraphNode &, const GraphNode &)> heuristic;
+	std::function<double(const Graph &, int, int)> heuristic;
 
    public:
-	AStar(std::function<double(const GraphNode &, const GraphNode &)> h =
-	          [](const GraphNode &n1, const GraphNode &n2) { return n1.getPosition().dist(n2.getPosition()); })
+	AStar(std::function<double(const Graph &, int, int)> h = [](const Graph &g, int n1,
+	                                                             int n2) { return g.distance(n1, n2); })
 	    : heuristic(h) {
 	}
 	std::optional<std::vector<int>> getPath(const Graph &, int, int) const;
@@ -0,0 +1,20 @@
+#ifndef BIDIRECTIONAL_ASTAR_H_
+#define BIDIRECTIONAL_ASTAR_H_
+
+#include "Graph.h"
+#include "RoutingStrategy.h"
+
+namespace routing {
+/**
+ * @class BidirectionalAStar
+ * @brief A* run from both ends at once with the average of the forward and
+ * backward straight line potentials, so both searches stay consistent and
+ * can stop as soon as their frontiers prove the best meeting point.
+ */
+class BidirectionalAStar : public RoutingStrategy {
+   public:
+	std::optional<std::vector<int>> getPath(const Graph &, int, int) const;
+};
+}  // namespace routing
+
+#endif  // BIDIRECTIONAL_ASTAR_H_
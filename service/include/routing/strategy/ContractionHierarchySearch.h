@@ -0,0 +1,20 @@
+#ifndef CONTRACTION_HIERARCHY_SEARCH_H_
+#define CONTRACTION_HIERARCHY_SEARCH_H_
+
+#include "Graph.h"
+#include "RoutingStrategy.h"
+
+namespace routing {
+/**
+ * @class ContractionHierarchySearch
+ * @brief Bidirectional Dijkstra over the upward edges of the graph's
+ * contraction hierarchy, unpacking shortcuts into the original nodes. Falls
+ * back to plain Dijkstra when the graph has no hierarchy.
+ */
+class ContractionHierarchySearch : public RoutingStrategy {
+   public:
+	std::optional<std::vector<int>> getPath(const Graph &, int, int) const;
+};
+}  // namespace routing
+
+#endif  // CONTRACTION_HIERARCHY_SEARCH_H_
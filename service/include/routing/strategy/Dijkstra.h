@@ -6,7 +6,7 @@
 namespace routing {
 class Dijkstra : public AStar {
    public:
-	Dijkstra() : AStar([](const GraphNode &, const GraphNode &) { return 0; }) {
+	Dijkstra() : AStar([](const Graph &, int, int) { return 0; }) {
 	}
 };
 }  // namespace routing
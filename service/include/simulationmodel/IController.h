@@ -1,6 +1,8 @@
 #ifndef CONTROLLER_H_
 #define CONTROLLER_H_
 
+#include <vector>
+
 #include "IEntity.h"
 #include "util/json.h"
 
@@ -26,6 +28,14 @@ class IController {
 	 **/
 	virtual void addEntity(const IEntity &entity) = 0;
 
+	/**
+	 * @brief Add several entities to the program at once
+	 * @param entities The entities, in the order they were created
+	 **/
+	virtual void addEntities(const std::vector<const IEntity *> &entities) {
+		for (const IEntity *entity : entities) addEntity(*entity);
+	}
+
 	/**
 	 * @brief To update the entity information and add it to the program
 	 * @param entity Type IEntity contain entity object
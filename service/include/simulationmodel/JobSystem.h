@@ -0,0 +1,103 @@
+#ifndef JOB_SYSTEM_H_
+#define JOB_SYSTEM_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class JobSystem
+ * @brief Helper threads shared by the models of a process. They run two kinds
+ * of work: the chunks of a parallelFor, which whoever calls it works on too,
+ * and background jobs such as path searches, which only helpers run. A thread
+ * waiting in parallelFor only ever runs chunks of its own loop, so a long
+ * background job or another session's work never lands inside its tick.
+ * Threads that have nothing to do sleep until there is work.
+ */
+class JobSystem {
+   public:
+	using Job = std::function<void()>;
+	using RangeJob = std::function<void(size_t, size_t)>;
+
+	/**
+	 * @brief Starts the helper threads
+	 *
+	 * @param threads Threads to run jobs on, counting the callers as one
+	 */
+	explicit JobSystem(int threads = 1);
+
+	/**
+	 * @brief Finishes the queued jobs and joins the helper threads
+	 */
+	~JobSystem();
+
+	JobSystem(const JobSystem &) = delete;
+	JobSystem &operator=(const JobSystem &) = delete;
+
+	/**
+	 * @brief Returns the number of threads jobs run on, counting the callers
+	 * as one
+	 */
+	int getThreadCount() const {
+		return workers.size() + 1;
+	}
+
+	/**
+	 * @brief Queues a job for a helper to run in the background. Without
+	 * helpers it only runs once someone waits for it with waitWhile.
+	 */
+	void submit(Job job);
+
+	/**
+	 * @brief Calls fn on consecutive ranges [begin, end) covering [0, count)
+	 * and returns once every call has finished. Ranges are split at multiples
+	 * of grain whatever the number of threads, so begin / grain can index
+	 * results that must not depend on it.
+	 */
+	void parallelFor(size_t count, size_t grain, const RangeJob &fn);
+
+	/**
+	 * @brief Blocks for as long as busy returns true, busy must turn false
+	 * when a background job finishes. Runs the background jobs on the calling
+	 * thread if there are no helpers to do it.
+	 */
+	void waitWhile(const std::function<bool()> &busy);
+
+   private:
+	/**
+	 * @class Batch
+	 * @brief Chunks of one parallelFor call, guarded by the system's mutex
+	 */
+	struct Batch {
+		size_t count;
+		size_t grain;
+		size_t chunks;
+		const RangeJob *fn;
+		// Next chunk to hand out and chunks finished
+		size_t next = 0;
+		size_t done = 0;
+		std::condition_variable finished;
+	};
+
+	bool runChunk(Batch &batch, std::unique_lock<std::mutex> &lock);
+	void runBackground(std::unique_lock<std::mutex> &lock);
+	void work();
+
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	// Helpers sleep on wake, waitWhile on idle
+	std::condition_variable wake;
+	std::condition_variable idle;
+	// parallelFor calls with chunks left to hand out, oldest first
+	std::vector<Batch *> batches;
+	std::deque<Job> background;
+	// Background jobs being run
+	long running = 0;
+	bool stopping = false;
+};
+
+#endif  // JOB_SYSTEM_H_
@@ -0,0 +1,122 @@
+#ifndef MOTION_STORE_H_
+#define MOTION_STORE_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "math/vector3.h"
+
+/**
+ * @class MotionStore
+ * @brief Component store for the kinematic state of a model's entities.
+ * Positions, directions and speeds live in parallel arrays rather than in
+ * each entity, so moving every entity is one pass over contiguous memory.
+ * Entities refer to their slot through a handle that stays valid while
+ * other entities come and go.
+ */
+class MotionStore {
+   public:
+	using Handle = int;
+
+	/**
+	 * @brief Adds an entity's state to the store
+	 * @return Handle of its slot
+	 */
+	Handle add(const Vector3 &position, const Vector3 &direction, double speed);
+
+	/**
+	 * @brief Frees the slot of a handle, the handle may be reused afterwards
+	 */
+	void remove(Handle h);
+
+	Vector3 getPosition(Handle h) const {
+		int i = slots[h];
+		return {px[i], py[i], pz[i]};
+	}
+
+	void setPosition(Handle h, const Vector3 &p) {
+		int i = slots[h];
+		px[i] = p.x;
+		py[i] = p.y;
+		pz[i] = p.z;
+	}
+
+	Vector3 getDirection(Handle h) const {
+		int i = slots[h];
+		return {dx[i], dy[i], dz[i]};
+	}
+
+	void setDirection(Handle h, const Vector3 &d) {
+		int i = slots[h];
+		dx[i] = d.x;
+		dy[i] = d.y;
+		dz[i] = d.z;
+	}
+
+	double getSpeed(Handle h) const {
+		return speed[slots[h]];
+	}
+
+	void setSpeed(Handle h, double s) {
+		speed[slots[h]] = s;
+	}
+
+	/**
+	 * @brief Has the entity head for target at its speed on the next
+	 * integrate. Only lasts for that one call, so an entity that stops being
+	 * driven simply stops.
+	 */
+	void drive(Handle h, const Vector3 &target) {
+		int i = slots[h];
+		tx[i] = target.x;
+		ty[i] = target.y;
+		tz[i] = target.z;
+		driven[i] = 1;
+	}
+
+	/**
+	 * @brief Moves every driven entity in the dense range [begin, end)
+	 * towards its target for dt seconds and faces it that way. Ranges that
+	 * do not overlap can be integrated on different threads.
+	 */
+	void integrate(double dt, size_t begin = 0, size_t end = SIZE_MAX);
+
+	/**
+	 * @brief Has the entity take the position and direction of carrier on
+	 * the next settle, once the carrier has moved. Like drive it only lasts
+	 * for one tick. Not thread safe, carriers call it from serial updates.
+	 */
+	void follow(Handle h, Handle carrier) {
+		followers.push_back({h, carrier});
+	}
+
+	/**
+	 * @brief Moves every entity that follows a carrier onto it, after the
+	 * carriers have been integrated
+	 */
+	void settle();
+
+	/**
+	 * @brief Returns the number of entities in the store
+	 */
+	size_t size() const {
+		return owners.size();
+	}
+
+   private:
+	// Dense arrays, index i belongs to handle owners[i]
+	std::vector<double> px, py, pz;
+	std::vector<double> dx, dy, dz;
+	std::vector<double> speed;
+	std::vector<double> tx, ty, tz;
+	std::vector<uint8_t> driven;
+	std::vector<Handle> owners;
+	// Dense index of each handle, -1 for free handles
+	std::vector<int> slots;
+	std::vector<Handle> freeHandles;
+	// Entity and carrier pairs to settle this tick
+	std::vector<std::pair<Handle, Handle>> followers;
+};
+
+#endif  // MOTION_STORE_H_
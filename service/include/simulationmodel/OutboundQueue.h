@@ -0,0 +1,86 @@
+#ifndef OUTBOUND_QUEUE_H_
+#define OUTBOUND_QUEUE_H_
+
+#include <string>
+#include <vector>
+
+#include "libwebsockets.h"
+
+/**
+ * @class OutboundQueue
+ * @brief Ring of reusable send buffers for one websocket session. Each
+ * buffer keeps the LWS_PRE bytes of headroom lws_write needs in front of
+ * the payload, so a message is copied in once and sent straight from the
+ * ring. Buffers keep their memory after being sent, so a session stops
+ * allocating once the ring has grown to its usual backlog.
+ */
+class OutboundQueue {
+   public:
+	/**
+	 * @class Buffer
+	 * @brief One queued message and the headroom in front of it
+	 */
+	class Buffer {
+		friend class OutboundQueue;
+
+	   public:
+		/**
+		 * @brief Start of the payload, LWS_PRE bytes into the buffer
+		 */
+		unsigned char *payload() {
+			return bytes.data() + LWS_PRE;
+		}
+
+		size_t size() const {
+			return length;
+		}
+
+		bool isBinary() const {
+			return binary;
+		}
+
+	   private:
+		std::vector<unsigned char> bytes;
+		size_t length = 0;
+		bool binary = false;
+	};
+
+	/**
+	 * @brief Queues a copy of data
+	 */
+	void push(const std::string &data, bool binary);
+
+	/**
+	 * @brief The oldest queued message
+	 */
+	Buffer &front() {
+		return slots[head];
+	}
+
+	/**
+	 * @brief The i-th oldest queued message
+	 */
+	Buffer &operator[](size_t i) {
+		return slots[(head + i) % slots.size()];
+	}
+
+	/**
+	 * @brief Drops the n oldest queued messages, keeping their buffers for reuse
+	 */
+	void pop(size_t n = 1);
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+   private:
+	std::vector<Buffer> slots;
+	size_t head = 0;
+	size_t count = 0;
+};
+
+#endif  // OUTBOUND_QUEUE_H_
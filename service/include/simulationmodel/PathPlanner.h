@@ -0,0 +1,63 @@
+#ifndef PATH_PLANNER_H_
+#define PATH_PLANNER_H_
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Graph.h"
+#include "JobSystem.h"
+#include "RoutingStrategy.h"
+#include "vector3.h"
+
+/**
+ * @class PathPlanner
+ * @brief Runs routing queries as jobs of the model's JobSystem. Requests are
+ * answered through futures so entities can keep updating while their path is
+ * being computed.
+ */
+class PathPlanner {
+   public:
+	using Path = std::optional<std::vector<Vector3>>;
+
+	/**
+	 * @brief Creates a planner that queues its requests on jobs
+	 *
+	 * @param jobs Job system to search on, which must outlive the planner
+	 */
+	explicit PathPlanner(JobSystem &jobs);
+
+	/**
+	 * @brief Finishes the queued requests
+	 */
+	~PathPlanner();
+
+	PathPlanner(const PathPlanner &) = delete;
+	PathPlanner &operator=(const PathPlanner &) = delete;
+
+	/**
+	 * @brief Queues a routing query on the graph
+	 *
+	 * @param graph Graph to search, which must outlive the request
+	 * @param start Start position
+	 * @param end End position
+	 * @param strategy Routing strategy to search with
+	 * @return Future holding the path, or nullopt if none was found
+	 */
+	std::future<Path> plan(const routing::Graph *graph, Vector3 start, Vector3 end,
+	                       std::shared_ptr<const routing::RoutingStrategy> strategy);
+
+	/**
+	 * @brief Blocks until every queued request has finished
+	 */
+	void drain();
+
+   private:
+	JobSystem &jobs;
+	// Requests queued or being searched
+	std::atomic<int> outstanding = 0;
+};
+
+#endif  // PATH_PLANNER_H_
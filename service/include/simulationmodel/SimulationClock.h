@@ -0,0 +1,88 @@
+#ifndef SIMULATION_CLOCK_H_
+#define SIMULATION_CLOCK_H_
+
+#include <chrono>  // NOLINT [build/c++11]
+
+/**
+ * @class SimulationClock
+ * @brief Fixed time step scheduler owned by the server. Wall time, scaled by
+ * the simulation speed, is accumulated and paid out in whole steps of
+ * 1 / rate simulated seconds. A cap on the steps per advance keeps a stalled
+ * server from answering with a huge catch-up burst; time beyond the cap is
+ * dropped.
+ */
+class SimulationClock {
+   public:
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @brief Construct a new Simulation Clock, starting now
+	 *
+	 * @param rate Steps per simulated second
+	 * @param maxSteps Most steps a single advance may return
+	 */
+	SimulationClock(double rate = 100, int maxSteps = 10);
+
+	/**
+	 * @brief Accumulates the wall time passed since the last advance
+	 *
+	 * @param now Current time
+	 * @return Number of fixed steps to simulate now
+	 */
+	int advance(Clock::time_point now = Clock::now());
+
+	/**
+	 * @brief Sets how many simulated seconds pass per wall second
+	 *
+	 * @param speed Simulation speed, negative values are treated as 0
+	 */
+	void setSpeed(double speed);
+
+	double getSpeed() const {
+		return speed;
+	}
+
+	/**
+	 * @brief Length of one step in simulated seconds
+	 */
+	double getStep() const {
+		return step;
+	}
+
+	/**
+	 * @brief Number of steps handed out so far
+	 */
+	long getTick() const {
+		return tick;
+	}
+
+	/**
+	 * @brief Simulated time at the end of the last step handed out
+	 */
+	double getTime() const {
+		return tick * step;
+	}
+
+	/**
+	 * @brief Fraction of the next step already accumulated, for
+	 *        interpolating between the last two states
+	 */
+	double getAlpha() const {
+		return accumulator / step;
+	}
+
+	/**
+	 * @brief Wall time until the next step is due at the current speed
+	 */
+	Clock::duration untilNextStep() const;
+
+   private:
+	double step;
+	int maxSteps;
+	double speed = 1;
+	double accumulator = 0;
+	long tick = 0;
+	Clock::time_point last;
+};
+
+#endif  // SIMULATION_CLOCK_H_
@@ -3,7 +3,11 @@
 
 #include <deque>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <set>
+#include <thread>  // NOLINT [build/c++11]
+#include <vector>
 
 #include "CompositeFactory.h"
 #include "Drone.h"
@@ -11,12 +15,14 @@
 #include "IController.h"
 #include "IEntity.h"
 #include "IObserver.h"
-#include "MultiDeliveryDecorator.h"
+#include "JobSystem.h"
+#include "MotionStore.h"
+#include "MultiDelivery.h"
 #include "POI.h"
+#include "PathPlanner.h"
 #include "Robot.h"
 
 class POI;
-class MultiDeliveryDecorator;
 
 //--------------------  Model ----------------------------
 
@@ -32,8 +38,10 @@ class SimulationModel : public IObserver {
 	/**
 	 * @brief Default constructor that create the SimulationModel object
 	 * @param controller The specified Controller to be initialized in the model
+	 * @param jobs Job system to run the model's jobs on, which may be shared
+	 * with other models and must outlive this one
 	 **/
-	SimulationModel(IController &controller);
+	SimulationModel(IController &controller, JobSystem &jobs);
 
 	/**
 	 * @brief Destructor
@@ -42,9 +50,9 @@ class SimulationModel : public IObserver {
 
 	/**
 	 * @brief Set the Graph for the SimulationModel
-	 * @param graph Type Graph* contain the new graph for SimulationModel
+	 * @param graph Shared graph for the SimulationModel, usually from the GraphRegistry
 	 **/
-	void setGraph(const routing::Graph *graph);
+	void setGraph(std::shared_ptr<const routing::Graph> graph);
 
 	/**
 	 * @brief Creates a new simulation entity
@@ -53,6 +61,25 @@ class SimulationModel : public IObserver {
 	 **/
 	IEntity *createEntity(const JsonObject &entity);
 
+	/**
+	 * @brief Creates several entities in one pass and adds them to the view
+	 * together
+	 * @param entities Array of entity descriptions, as for createEntity
+	 * @return The entities that were created
+	 **/
+	std::vector<IEntity *> createEntities(const JsonArray &entities);
+
+	/**
+	 * @brief Loads a scene file of view commands. Its graph is set, its
+	 * entities are created as one batch and its trips are scheduled after
+	 * them. Commands that only concern the view are skipped.
+	 * @param path Path of the scene file, relative to the working directory
+	 * @param root Web root the scene was written for, its file paths are
+	 *             relative to it like the meshes the view loads
+	 * @return Whether the file could be read
+	 **/
+	bool loadScene(const std::string &path, const std::string &root = "");
+
 	/**
 	 * @brief Removes entity with given ID from the simulation
 	 *
@@ -86,6 +113,45 @@ class SimulationModel : public IObserver {
 	 */
 	const routing::Graph *getGraph() const;
 
+	/**
+	 * @brief Returns the planner that computes entity paths off the
+	 *        simulation thread
+	 *
+	 * @returns PathPlanner* planner pointer
+	 */
+	PathPlanner *getPathPlanner();
+
+	/**
+	 * @brief Get the store holding the position, direction and speed of
+	 *        every entity linked to this model
+	 *
+	 * @return The model's MotionStore
+	 **/
+	MotionStore *getMotionStore();
+
+	/**
+	 * @brief Get the job system entity updates, proximity checks and path
+	 *        planning run on
+	 *
+	 * @return The model's JobSystem
+	 **/
+	JobSystem *getJobSystem();
+
+	/**
+	 * @brief Sets whether every tick waits for the routes requested during
+	 *        it. Routes then arrive on the next tick however long they take
+	 *        to search, so a run is repeatable at the cost of the time spent
+	 *        waiting. Otherwise they arrive whenever their search is done.
+	 *
+	 * @param deterministic Whether to wait for routes every tick
+	 **/
+	void setDeterministic(bool deterministic);
+
+	/**
+	 * @brief Get whether every tick waits for the routes requested during it
+	 **/
+	bool isDeterministic() const;
+
 	/**
 	 * @brief Notifies observer with specific message
 	 *
@@ -130,9 +196,17 @@ class SimulationModel : public IObserver {
 
 	std::vector<POI *> pois;
 
-	std::vector<MultiDeliveryDecorator *> drones;
+	std::vector<MultiDeliveryDrone *> drones;
 
    protected:
+	/**
+	 * @brief Creates an entity and adds it to the model, without telling the view
+	 **/
+	IEntity *buildEntity(const JsonObject &entity);
+
+	// Pools the entities and strategies of this model are allocated from,
+	// freed ones are reused by the next of the same size
+	std::pmr::synchronized_pool_resource arena;
 	// Keeps track of all pois and drones in the simulation
 	std::map<int, IEntity *> entities;
 	std::set<int> removed;
@@ -141,9 +215,20 @@ class SimulationModel : public IObserver {
 	 * @param id The id of the model to be removed
 	 */
 	void removeFromSim(int id);
-	const routing::Graph *graph = nullptr;
+	std::shared_ptr<const routing::Graph> graph;
 	CompositeFactory entityFactory;
 	std::vector<Vector3> rechargeStations;
+	// May be shared with other models, the simulation comes out bit for bit
+	// the same whatever its number of threads
+	JobSystem &jobs;
+	PathPlanner planner;
+	bool deterministic = false;
+	MotionStore motion;
+	// Update order, entities that only touch their own state are updated in
+	// parallel and the rest one by one after them, each list in id order
+	std::vector<IEntity *> parallelOrder;
+	std::vector<IEntity *> serialOrder;
+	bool orderChanged = true;
 };
 
 #endif
@@ -5,6 +5,9 @@ Copyright (c) 2019 Dan Orban
 #ifndef WEBSERVER_H_
 #define WEBSERVER_H_
 
+#include <atomic>
+#include <cstdint>
+#include <iostream>
 #include <map>
 #include <string>
 #include <vector>
@@ -30,6 +33,14 @@ class WebServerBase {
 	 */
 	virtual ~WebServerBase();
 
+	/**
+	 * @brief A message queued for a client, sent as a text or binary frame
+	 */
+	struct Message {
+		std::string data;
+		bool binary = false;
+	};
+
 	/**
 	 * @class Session
 	 * @brief Represents a session with a client
@@ -68,6 +79,28 @@ class WebServerBase {
 		 */
 		virtual void sendMessage(const std::string &msg);
 
+		/**
+		 * @brief Sends raw bytes to the client as a binary frame
+		 * @param data The bytes to send to the client
+		 */
+		virtual void sendBinary(const std::string &data);
+
+		/**
+		 * @brief Returns how many bytes are queued for the client but not yet
+		 * written to its socket, safe to call from any thread
+		 */
+		size_t getQueuedBytes() const {
+			return queuedBytes;
+		}
+
+		/**
+		 * @brief Returns the backlog above which the session should hold back
+		 * messages that a later one supersedes
+		 */
+		size_t getBacklogLimit() const {
+			return backlogLimit;
+		}
+
 		/**
 		 * @brief Performs any necessary updates for the session
 		 */
@@ -76,17 +109,38 @@ class WebServerBase {
 
 		/**
 		 * @brief Function called when the session is ready to write
+		 * @return False if a write failed and the connection has to be closed
 		 */
-		virtual void onWrite();
+		virtual bool onWrite();
+
+		/**
+		 * @brief Called on the server thread once the connection has closed,
+		 * the session is deleted as soon as isFinished returns true
+		 */
+		virtual void close() {
+		}
+
+		/**
+		 * @brief Whether a closed session is done with its own work, so
+		 * deleting it does not hold up the server
+		 */
+		virtual bool isFinished() const {
+			return true;
+		}
 
 	   private:
+		void queueMessage(const std::string &data, bool binary);
+
 		void *state;
 		int id;
+		std::atomic<size_t> queuedBytes = 0;
+		std::atomic<size_t> backlogLimit = SIZE_MAX;
 	};
 
 	/**
 	 * @brief Services the server, processing incoming requests
-	 * @param time Time for which to service the server
+	 * @param time Longest time in milliseconds to wait for network events
+	 *             before returning, so sessions are updated at least this often
 	 */
 	void service(int time = 10);
 
@@ -96,6 +150,13 @@ class WebServerBase {
 	 */
 	virtual void createSession(void *info);
 
+	/**
+	 * @brief Stops updating the session of a closed connection and deletes it
+	 * once it has finished
+	 * @param session The session to close
+	 */
+	void closeSession(Session *session);
+
    protected:
 	/**
 	 * @brief Factory method to create a new session
@@ -106,8 +167,21 @@ class WebServerBase {
 
    public:
 	lws_context *context = nullptr;
+	lws_sorted_usec_list_t wakeTimer;
+	// Most bytes to pack into one websocket frame when several messages are
+	// queued, 0 sends every message in its own frame. Applies to sessions
+	// created after it is set.
+	size_t frameBudget = 64 * 1024;
+	// Queued bytes above which sessions hold back superseded updates, they
+	// keep sending everything else in order
+	size_t backlogLimit = 1024 * 1024;
+	// Queued bytes above which a client is too slow to keep, its session is
+	// closed rather than letting the queue grow without bound
+	size_t maxBacklog = 16 * 1024 * 1024;
 	std::vector<Session *> sessions;
 	std::map<int, Session *> sessionMap;
+	// Sessions whose connection closed, waiting to finish before deletion
+	std::vector<Session *> closedSessions;
 	std::string webDir;
 };
 
@@ -190,22 +264,16 @@ class JSONSession : public WebServerBase::Session {
 
 	/**
 	 * @brief Receives a message from the client and parses it as JSON
-	 * @param msg The message received from the client
+	 * @param msg The message received from the client, the server reassembles
+	 * fragmented messages before passing them on
 	 */
 	void receiveMessage(const std::string &msg) {
-		static std::string buf = "";
 		picojson::value val;
 		std::string err = picojson::parse(val, msg);
 		if (err.empty() && val.is<picojson::object>()) {
-			buf = "";
 			receiveJSON(val);
 		} else {
-			buf += msg;
-			err = picojson::parse(val, buf);
-			if (err.empty() && val.is<picojson::object>()) {
-				buf = "";
-				receiveJSON(val);
-			}
+			std::cerr << "Ignoring malformed message: " << err << std::endl;
 		}
 	}
 };
@@ -223,7 +291,8 @@ class JsonSession : public JSONSession {
 	 * @param val: the command (in JSON format)
 	 */
 	void receiveJSON(picojson::value &val) {
-		JsonObject data = JsonValue(val);
+		// Take over the parsed object rather than copying it, the caller is done with it
+		JsonObject data(std::move(val.get<picojson::object>()));
 
 		std::string cmd = data["command"];
 
@@ -231,7 +300,7 @@ class JsonSession : public JSONSession {
 		returnValue["id"] = data["id"];
 
 		receiveCommand(cmd, data, returnValue);
-		JsonValue retVal(returnValue);
+		JsonValue retVal(std::move(returnValue));
 		sendJSON(retVal.getValue());
 	}
 
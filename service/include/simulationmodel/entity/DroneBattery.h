@@ -1,32 +1,36 @@
-#pragma once
+#ifndef DRONE_BATTERY_H_
+#define DRONE_BATTERY_H_
 
-#include "DroneDecorator.h"
-#include "SimulationModel.h"
+#include <concepts>
+
+#include "Drone.h"
 
 /**
- * @class DroneBatteryDecorator
- * @brief Decorator class for adding battery to a drone
+ * @class DroneBattery
+ * @brief Policy layer adding a battery to the drone type it is layered onto
  *        Responsible for charging, discharging, and finding recharge stations
  *
  */
-class DroneBatteryDecorator : public DroneDecorator {
+template <std::derived_from<Drone> Base = Drone>
+class DroneBattery : public Base {
    public:
 	/**
-	 * @brief Construct a new Drone Battery Decorator object
+	 * @brief Construct a new drone with a battery
 	 *
-	 * @param drone The drone to be added battery to
+	 * @param obj JSON object containing the drone's information
 	 * @param maxCharge_ Maximum charge the drone can have
 	 * @param currentCharge_ Current charge the drone has
+	 * @param lowCharge_ Charge the drone heads for a recharge station at
 	 * @param decreaseTime_ Time it takes for the drone to decrease 2% charge
 	 */
-	DroneBatteryDecorator(Drone *drone, unsigned maxCharge_, unsigned currentCharge_, unsigned lowCharge_,
-	                      double decreaseTime_);
+	DroneBattery(const JsonObject &obj, unsigned maxCharge_ = 100, unsigned currentCharge_ = 100,
+	             unsigned lowCharge_ = 20, double decreaseTime_ = 4.0);
 
 	/**
-	 * @brief Destroy the Drone Battery Decorator object
+	 * @brief Destroy the drone
 	 *
 	 */
-	virtual ~DroneBatteryDecorator();
+	virtual ~DroneBattery();
 
 	/**
 	 * @brief Decrease the charge of the drone,
@@ -65,7 +69,7 @@ class DroneBatteryDecorator : public DroneDecorator {
 	 *
 	 * @param dt Time elapsed
 	 */
-	void update(double dt);
+	void update(double dt) override;
 
 	/**
 	 * @brief Determine if the drone is at the recharge station
@@ -144,3 +148,5 @@ class DroneBatteryDecorator : public DroneDecorator {
 	bool goingToFinalDestination = false;
 	double malfunctionedStationTime = 0;
 };
+
+#endif  // DRONE_BATTERY_H_
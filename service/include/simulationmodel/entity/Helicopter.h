@@ -1,6 +1,8 @@
 #ifndef Helicopter_H_
 #define Helicopter_H_
 
+#include <random>
+
 #include "IEntity.h"
 #include "IStrategy.h"
 
@@ -28,7 +30,18 @@ class Helicopter : public IEntity {
 	 */
 	void update(double dt);
 
+	/**
+	 * @brief Helicopters only change themselves when they update
+	 * @return True
+	 */
+	bool isSelfContained() const {
+		return true;
+	}
+
    private:
+	// Own generator for picking destinations, so updating on any thread
+	// gives the same walk
+	std::minstd_rand rng;
 	IStrategy *movement = nullptr;
 	double distanceTraveled = 0;
 	unsigned int mileCounter = 0;
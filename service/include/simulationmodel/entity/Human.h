@@ -1,6 +1,8 @@
 #ifndef HUMAN_H_
 #define HUMAN_H_
 
+#include <random>
+
 #include "IEntity.h"
 #include "IStrategy.h"
 
@@ -28,7 +30,18 @@ class Human : public IEntity {
 	 */
 	void update(double dt);
 
+	/**
+	 * @brief Humans only change themselves when they update
+	 * @return True
+	 */
+	bool isSelfContained() const {
+		return true;
+	}
+
    private:
+	// Own generator for picking destinations, so updating on any thread
+	// gives the same walk
+	std::minstd_rand rng;
 	static Vector3 kellerPosition;
 	IStrategy *movement = nullptr;
 	bool atKeller = false;
@@ -5,7 +5,9 @@
 
 #include "Graph.h"
 #include "IPublisher.h"
+#include "MotionStore.h"
 #include "math/vector3.h"
+#include "util/Pooled.h"
 #include "util/json.h"
 
 class SimulationModel;
@@ -19,7 +21,7 @@ class SimulationModel;
  * in the physical system. Subclasses of IEntity can override the `Update`
  * function to implement their own movement behavior.
  */
-class IEntity : public IPublisher {
+class IEntity : public IPublisher, public Pooled {
    public:
 	/**
 	 * @brief Constructor that assigns a unique ID to the entity.
@@ -87,6 +89,12 @@ class IEntity : public IPublisher {
 	 */
 	virtual double getSpeed() const;
 
+	/**
+	 * @brief Sets the speed of the entity.
+	 * @param speed_ The new speed of the entity.
+	 */
+	virtual void setSpeed(double speed_);
+
 	/**
 	 * @brief Sets the position of the entity.
 	 * @param pos_ The desired position of the entity.
@@ -111,6 +119,33 @@ class IEntity : public IPublisher {
 	 */
 	virtual void rotate(double angle);
 
+	/**
+	 * @brief Has the model move the entity towards target at its speed once
+	 * every entity has updated this tick.
+	 * @param target Where to head for.
+	 * @return False if the entity is not linked to a model, and has to move
+	 * itself.
+	 */
+	virtual bool drive(const Vector3 &target);
+
+	/**
+	 * @brief Has the model put the entity on carrier, with its direction,
+	 * once carrier has moved this tick.
+	 * @param carrier The entity carrying this one.
+	 * @return False if either entity is not linked to a model, and the
+	 * entity has to be moved directly.
+	 */
+	virtual bool follow(const IEntity &carrier);
+
+	/**
+	 * @brief Whether update only changes the entity itself, apart from
+	 * notifying observers, so the model may update it alongside others.
+	 * @return False unless the entity says otherwise.
+	 */
+	virtual bool isSelfContained() const {
+		return false;
+	}
+
 	/**
 	 * @brief Updates the entity's position in the physical system.
 	 * @param dt The time step of the update.
@@ -121,6 +156,10 @@ class IEntity : public IPublisher {
 
    protected:
 	SimulationModel *model = nullptr;
+	// Where the position, direction and speed live once linked to a model,
+	// until then the fields below hold them
+	MotionStore *motion = nullptr;
+	MotionStore::Handle motionHandle = -1;
 	int id = -1;
 	JsonObject details;
 	Vector3 position;
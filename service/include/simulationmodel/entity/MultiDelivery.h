@@ -1,44 +1,40 @@
-#ifndef MULTI_DELIVERY_DECORATOR_H_
-#define MULTI_DELIVERY_DECORATOR_H_
+#ifndef MULTI_DELIVERY_H_
+#define MULTI_DELIVERY_H_
+
+#include <concepts>
+#include <vector>
 
-#include "BeelineStrategy.h"
 #include "Drone.h"
-#include "DroneDecorator.h"
+#include "IObserver.h"
 #include "Package.h"
-#include "PathStrategy.h"
-#include "SimulationModel.h"
 
 /**
- * @class MultiDeliveryDecorator
- * @brief Decorator allowing for drones to make multiple deliveries, inherits from IObserver and DroneDecorator
+ * @class MultiDelivery
+ * @brief Policy layer allowing for drones to make multiple deliveries, inherits from IObserver and the drone
+ * type it is layered onto. The layers of a drone make up one object, so nothing is forwarded between them.
  **/
-class MultiDeliveryDecorator : public DroneDecorator, public IObserver {
+template <std::derived_from<Drone> Base = Drone>
+class MultiDelivery : public Base, public IObserver {
    public:
 	/**
 	 * @brief Constructor
 	 *
-	 * @param Drone* Drone to add functionality onto
+	 * @param obj JSON object containing the drone's information
 	 */
-	MultiDeliveryDecorator(Drone *d);
+	MultiDelivery(const JsonObject &obj);
 
 	/**
 	 * @brief Destructor
 	 */
-	~MultiDeliveryDecorator() {
+	~MultiDelivery() {
 	}
 
 	/**
-	 * @brief Updates the child drone's position
+	 * @brief Updates the drone's position and the packages it carries
 	 * @param dt Delta time
 	 */
 	void update(double dt) override;
 
-	/**
-	 * @brief Links decorator to simulation and stores pointer
-	 * @param model Simulation model
-	 */
-	void linkModel(SimulationModel *model);
-
 	/**
 	 * @brief Pickups additional package if drone is in range
 	 * @param d Location of POI to make pickup at
@@ -69,8 +65,10 @@ class MultiDeliveryDecorator : public DroneDecorator, public IObserver {
 	// All packages currently held by drone
 	std::vector<Package *> packages;
 
-	SimulationModel *m = nullptr;
 	Package *extra_package = nullptr;
 };
 
-#endif  // MULTI_DELIVERY_DECORATOR_H_
+/// Drone that POIs can prompt for extra deliveries, whatever else it is composed with
+using MultiDeliveryDrone = MultiDelivery<Drone>;
+
+#endif  // MULTI_DELIVERY_H_
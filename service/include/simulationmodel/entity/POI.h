@@ -1,10 +1,12 @@
 #ifndef POI_H
 #define POI_H
 
-#include "IEntity.h"
-#include "MultiDeliveryDecorator.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
 
-class MultiDeliveryDecorator;
+#include "IEntity.h"
+#include "MultiDelivery.h"
 
 /**
  * @class POI
@@ -22,11 +24,11 @@ class POI : public IEntity {
 
 	/**
 	 * @brief Constructor
-	 * @param e MultiDeliveryDecorator associated with observer to POI
+	 * @param e Drone associated with observer to POI
 	 * @param o Observer object to POI
 	 */
-	void addEntityObserverCombo(MultiDeliveryDecorator *e, IObserver *o) {
-		entity_observers[e] = o;
+	void addEntityObserverCombo(MultiDeliveryDrone *e, IObserver *o) {
+		entity_observers.emplace_back(e, o);
 	}
 
 	/**
@@ -39,17 +41,20 @@ class POI : public IEntity {
 	 * @brief Prompts the user to make an additional stop
 	 * @param d Drone that can be rerouted to POI
 	 */
-	void promptUser(MultiDeliveryDecorator *d);
+	void promptUser(MultiDeliveryDrone *d);
 
 	/**
 	 * @brief Facilitates drone pitstop at POI
 	 * @param d Drone that reroutes to POI
 	 */
-	void pitStopHere(MultiDeliveryDecorator *d);
+	void pitStopHere(MultiDeliveryDrone *d);
 
    private:
-	// Stores pair of drones and their accompanying observe models
-	std::map<MultiDeliveryDecorator *, IObserver *> entity_observers;
+	// Stores pair of drones and their accompanying observe models, in the
+	// order they were added so drones are checked the same way every run
+	std::vector<std::pair<MultiDeliveryDrone *, IObserver *>> entity_observers;
+	// Whether each drone was in range on this update
+	std::vector<uint8_t> nearby;
 };
 
 #endif  // POI_H
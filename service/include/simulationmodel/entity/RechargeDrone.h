@@ -54,7 +54,7 @@ class RechargeDrone : public IEntity {
    private:
 	bool available;
 	bool isChargingDrone;
-	IStrategy *toDeadDrone;
-	IStrategy *toChargingStation;
-	Drone *deadDrone;
+	IStrategy *toDeadDrone = nullptr;
+	IStrategy *toChargingStation = nullptr;
+	Drone *deadDrone = nullptr;
 };
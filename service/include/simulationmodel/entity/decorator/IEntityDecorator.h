@@ -94,6 +94,14 @@ class IEntityDecorator : public T {
 		return sub->getSpeed();
 	}
 
+	/**
+	 * @brief Sets the speed of the entity.
+	 * @param speed_ The new speed of the entity.
+	 */
+	virtual void setSpeed(double speed_) {
+		sub->setSpeed(speed_);
+	}
+
 	/**
 	 * @brief Sets the position of the entity.
 	 * @param pos_ The desired position of the entity.
@@ -126,6 +134,32 @@ class IEntityDecorator : public T {
 		return sub->rotate(angle);
 	}
 
+	/**
+	 * @brief Has the model move the entity towards target.
+	 * @param target Where to head for.
+	 * @return False if the entity has to move itself.
+	 */
+	virtual bool drive(const Vector3 &target) {
+		return sub->drive(target);
+	}
+
+	/**
+	 * @brief Has the model put the entity on carrier once carrier has moved.
+	 * @param carrier The entity carrying this one.
+	 * @return False if the entity has to be moved directly.
+	 */
+	virtual bool follow(const IEntity &carrier) {
+		return sub->follow(carrier);
+	}
+
+	/**
+	 * @brief Whether update only changes the entity itself.
+	 * @return False, a decorator may change whatever it likes.
+	 */
+	virtual bool isSelfContained() const {
+		return false;
+	}
+
 	/**
 	 * @brief Updates the entity's position in the physical system.
 	 * @param dt The time step of the update.
@@ -0,0 +1,24 @@
+#ifndef ALT_STRATEGY_H_
+#define ALT_STRATEGY_H_
+
+#include "Graph.h"
+#include "PathStrategy.h"
+
+/**
+ * @class AltStrategy
+ * @brief this class inhertis from the PathStrategy class and is responsible for
+ * generating an ALT (A* with landmarks) path that the drone will take.
+ */
+class AltStrategy : public PathStrategy {
+   public:
+	/**
+	 * @brief Construct a new Alt Strategy object
+	 *
+	 * @param position Current position
+	 * @param destination End destination
+	 * @param graph Graph/Nodes of the map
+	 * @param planner Planner to compute the path on, or nullptr to compute it now
+	 */
+	AltStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph, PathPlanner *planner = nullptr);
+};
+#endif  // ALT_STRATEGY_H_
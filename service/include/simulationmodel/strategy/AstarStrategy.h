@@ -17,7 +17,8 @@ class AstarStrategy : public PathStrategy {
 	 * @param position Current position
 	 * @param destination End destination
 	 * @param graph Graph/Nodes of the map
+	 * @param planner Planner to compute the path on, or nullptr to compute it now
 	 */
-	AstarStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph);
+	AstarStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph, PathPlanner *planner = nullptr);
 };
 #endif  // ASTAR_STRATEGY_H_
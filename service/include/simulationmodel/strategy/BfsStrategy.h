@@ -17,7 +17,8 @@ class BfsStrategy : public PathStrategy {
 	 * @param position Current position
 	 * @param destination End destination
 	 * @param graph Graph/Nodes of the map
+	 * @param planner Planner to compute the path on, or nullptr to compute it now
 	 */
-	BfsStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph);
+	BfsStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph, PathPlanner *planner = nullptr);
 };
 #endif  // BFS_STRATEGY_H_
@@ -0,0 +1,25 @@
+#ifndef BIDIRECTIONAL_ASTAR_STRATEGY_H_
+#define BIDIRECTIONAL_ASTAR_STRATEGY_H_
+
+#include "Graph.h"
+#include "PathStrategy.h"
+
+/**
+ * @class BidirectionalAstarStrategy
+ * @brief this class inhertis from the PathStrategy class and is responsible for
+ * generating the bidirectional astar path that the drone will take.
+ */
+class BidirectionalAstarStrategy : public PathStrategy {
+   public:
+	/**
+	 * @brief Construct a new Bidirectional Astar Strategy object
+	 *
+	 * @param position Current position
+	 * @param destination End destination
+	 * @param graph Graph/Nodes of the map
+	 * @param planner Planner to compute the path on, or nullptr to compute it now
+	 */
+	BidirectionalAstarStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph,
+	                           PathPlanner *planner = nullptr);
+};
+#endif  // BIDIRECTIONAL_ASTAR_STRATEGY_H_
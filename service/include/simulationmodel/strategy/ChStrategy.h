@@ -0,0 +1,24 @@
+#ifndef CH_STRATEGY_H_
+#define CH_STRATEGY_H_
+
+#include "Graph.h"
+#include "PathStrategy.h"
+
+/**
+ * @class ChStrategy
+ * @brief this class inhertis from the PathStrategy class and is responsible for
+ * generating a contraction hierarchy path that the drone will take.
+ */
+class ChStrategy : public PathStrategy {
+   public:
+	/**
+	 * @brief Construct a new Ch Strategy object
+	 *
+	 * @param position Current position
+	 * @param destination End destination
+	 * @param graph Graph/Nodes of the map
+	 * @param planner Planner to compute the path on, or nullptr to compute it now
+	 */
+	ChStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph, PathPlanner *planner = nullptr);
+};
+#endif  // CH_STRATEGY_H_
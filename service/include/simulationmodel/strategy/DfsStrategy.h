@@ -17,7 +17,8 @@ class DfsStrategy : public PathStrategy {
 	 * @param position Current position
 	 * @param destination End destination
 	 * @param graph Graph/Nodes of the map
+	 * @param planner Planner to compute the path on, or nullptr to compute it now
 	 */
-	DfsStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph);
+	DfsStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph, PathPlanner *planner = nullptr);
 };
 #endif  // DFS_STRATEGY_H_
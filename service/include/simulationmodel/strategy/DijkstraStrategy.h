@@ -17,7 +17,9 @@ class DijkstraStrategy : public PathStrategy {
 	 * @param position Current position
 	 * @param destination End destination
 	 * @param graph Graph/Nodes of the map
+	 * @param planner Planner to compute the path on, or nullptr to compute it now
 	 */
-	DijkstraStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph);
+	DijkstraStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph,
+	                 PathPlanner *planner = nullptr);
 };
 #endif  // DIJKSTRA_STRATEGY_H_
@@ -2,13 +2,14 @@
 #define I_STRATEGY_H_
 
 #include "IEntity.h"
+#include "util/Pooled.h"
 
 /**
  * @class IStrategy
  * @brief Strategy interface
  *
  */
-class IStrategy {
+class IStrategy : public Pooled {
    public:
 	/**
 	 * @brief Destructor
@@ -31,6 +32,15 @@ class IStrategy {
 	 */
 	virtual bool isCompleted() = 0;
 
+	/**
+	 * @brief Check if the strategy is still waiting for its path
+	 *
+	 * @return True if the path is still being computed
+	 */
+	virtual bool isPending() {
+		return false;
+	}
+
 	/**
 	 * @brief Get the current distance of the entire path starting from startPosition
 	 *        and the current index
@@ -1,7 +1,13 @@
 #ifndef PATH_STRATEGY_H_
 #define PATH_STRATEGY_H_
 
+#include <future>
+#include <memory>
+
+#include "Graph.h"
 #include "IStrategy.h"
+#include "PathPlanner.h"
+#include "RoutingStrategy.h"
 
 /**
  * @class PathStrategy
@@ -12,6 +18,28 @@ class PathStrategy : public IStrategy {
    protected:
 	std::vector<Vector3> path;
 	int index;
+	// Path still being computed by the PathPlanner
+	std::future<PathPlanner::Path> pending;
+	Vector3 destination;
+
+	/**
+	 * @brief Construct a strategy that follows a route on the graph to destination
+	 *
+	 * @param position Current position
+	 * @param destination End destination
+	 * @param graph Graph/Nodes of the map
+	 * @param search Routing strategy used to find the route
+	 * @param planner Planner to compute the route on, or nullptr to compute it now
+	 */
+	PathStrategy(Vector3 position, Vector3 destination, const routing::Graph *graph,
+	             std::shared_ptr<const routing::RoutingStrategy> search, PathPlanner *planner);
+
+	/**
+	 * @brief Follows the found route and then moves on to the destination
+	 *
+	 * @param route The route found on the graph
+	 */
+	void setRoute(const PathPlanner::Path &route);
 
    public:
 	/**
@@ -37,6 +65,14 @@ class PathStrategy : public IStrategy {
 	 */
 	virtual bool isCompleted();
 
+	/**
+	 * @brief Check if the path is still being computed, picking it up if
+	 *        it has just arrived
+	 *
+	 * @return True if the path has not arrived yet
+	 */
+	virtual bool isPending();
+
 	/**
 	 * @brief Get the total distance of the entire path starting from startPosition
 	 *        and the current index
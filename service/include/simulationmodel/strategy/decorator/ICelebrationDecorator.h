@@ -42,6 +42,13 @@ class ICelebrationDecorator : public IStrategy {
 	 */
 	virtual bool isCompleted();
 
+	/**
+	 * @brief Check if the decorated strategy is still waiting for its path
+	 *
+	 * @return True if the path is still being computed
+	 */
+	virtual bool isPending();
+
 	/**
 	 * @brief Make the entity celebrate.
 	 *
@@ -0,0 +1,60 @@
+#ifndef BINARY_WRITER_H_
+#define BINARY_WRITER_H_
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class BinaryWriter
+ * @brief Packs numbers and strings into a byte buffer in little endian
+ * order, the layout a browser's DataView reads with littleEndian set.
+ */
+class BinaryWriter {
+   public:
+	/**
+	 * @brief Appends an arithmetic value with no padding
+	 */
+	template <typename T>
+	void put(T value) {
+		static_assert(std::is_arithmetic_v<T>);
+		char bytes[sizeof(T)];
+		std::memcpy(bytes, &value, sizeof(T));
+		if constexpr (std::endian::native == std::endian::big) std::reverse(bytes, bytes + sizeof(T));
+		data.append(bytes, sizeof(T));
+	}
+
+	/**
+	 * @brief Appends the string's length as an unsigned 32 bit value,
+	 * followed by its bytes
+	 */
+	void putString(const std::string &s) {
+		put<uint32_t>(s.size());
+		data.append(s);
+	}
+
+	/**
+	 * @brief Returns the bytes written so far
+	 */
+	const std::string &str() const {
+		return data;
+	}
+
+	/**
+	 * @brief Takes the bytes written so far, leaving the writer empty
+	 */
+	std::string take() {
+		std::string out = std::move(data);
+		data.clear();
+		return out;
+	}
+
+   private:
+	std::string data;
+};
+
+#endif  // BINARY_WRITER_H_
@@ -0,0 +1,61 @@
+#ifndef POOLED_H_
+#define POOLED_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+/**
+ * @class Pooled
+ * @brief Base for types that are created and destroyed all the time, such as
+ * entities and movement strategies. new takes them from the memory resource
+ * the current thread is working for, normally the pools of a session's model,
+ * and delete hands them back to whichever resource they came from so the
+ * block is reused by the next object of that size. Objects made while no
+ * resource is set come from the heap as usual.
+ */
+class Pooled {
+   public:
+	/**
+	 * @class Scope
+	 * @brief Makes new take pooled objects from resource on this thread until
+	 * the scope ends
+	 */
+	class Scope {
+	   public:
+		explicit Scope(std::pmr::memory_resource *resource) : outer(current) {
+			current = resource;
+		}
+
+		~Scope() {
+			current = outer;
+		}
+
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+
+	   private:
+		std::pmr::memory_resource *outer;
+	};
+
+	static void *operator new(std::size_t size) {
+		std::pmr::memory_resource *resource = current ? current : std::pmr::new_delete_resource();
+		// The resource is kept in front of the object, delete may run on
+		// another thread or after the scope has ended
+		void *block = resource->allocate(header + size, alignof(std::max_align_t));
+		*static_cast<std::pmr::memory_resource **>(block) = resource;
+		return static_cast<std::byte *>(block) + header;
+	}
+
+	static void operator delete(void *p, std::size_t size) {
+		void *block = static_cast<std::byte *>(p) - header;
+		std::pmr::memory_resource *resource = *static_cast<std::pmr::memory_resource **>(block);
+		resource->deallocate(block, header + size, alignof(std::max_align_t));
+	}
+
+   private:
+	static constexpr std::size_t header = alignof(std::max_align_t);
+	static inline thread_local std::pmr::memory_resource *current = nullptr;
+};
+
+#endif  // POOLED_H_
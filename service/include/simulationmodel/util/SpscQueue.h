@@ -0,0 +1,89 @@
+#ifndef SPSC_QUEUE_H_
+#define SPSC_QUEUE_H_
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+/**
+ * @class SpscQueue
+ * @brief Unbounded lock-free queue for exactly one producer thread and one
+ * consumer thread. The producer links nodes at the tail and the consumer
+ * advances the head past them. Nodes the consumer is done with are reused by
+ * the producer, so once the queue has grown to its usual backlog pushing
+ * no longer allocates nodes.
+ */
+template <typename T>
+class SpscQueue {
+   public:
+	SpscQueue() {
+		Node *node = new Node();
+		head = node;
+		tail = node;
+		first = node;
+		seen = node;
+	}
+
+	~SpscQueue() {
+		// Every node is still linked, from the oldest reusable one on
+		while (first) {
+			Node *next = first->next.load(std::memory_order_relaxed);
+			delete first;
+			first = next;
+		}
+	}
+
+	SpscQueue(const SpscQueue &) = delete;
+	SpscQueue &operator=(const SpscQueue &) = delete;
+
+	/**
+	 * @brief Adds a value, only called from the producer thread
+	 */
+	void push(T value) {
+		Node *node = reuse();
+		node->value.emplace(std::move(value));
+		node->next.store(nullptr, std::memory_order_relaxed);
+		tail->next.store(node, std::memory_order_release);
+		tail = node;
+	}
+
+	/**
+	 * @brief Removes the oldest value, only called from the consumer thread
+	 * @return Whether there was a value to move into out
+	 */
+	bool pop(T &out) {
+		Node *h = head.load(std::memory_order_relaxed);
+		Node *next = h->next.load(std::memory_order_acquire);
+		if (!next) return false;
+		out = std::move(*next->value);
+		next->value.reset();
+		// Hands h back to the producer
+		head.store(next, std::memory_order_release);
+		return true;
+	}
+
+   private:
+	struct Node {
+		std::optional<T> value;
+		std::atomic<Node *> next = nullptr;
+	};
+
+	// Takes the oldest node the consumer has moved past, or a new one
+	Node *reuse() {
+		if (first == seen) seen = head.load(std::memory_order_acquire);
+		if (first == seen) return new Node();
+		Node *node = first;
+		first = first->next.load(std::memory_order_relaxed);
+		return node;
+	}
+
+	// Consumer: the consumed placeholder, values start after it
+	alignas(64) std::atomic<Node *> head;
+	// Producer: the newest node, the oldest one not yet reused and the head
+	// as it last saw it, nodes from first up to seen are free
+	alignas(64) Node *tail;
+	Node *first;
+	Node *seen;
+};
+
+#endif  // SPSC_QUEUE_H_
@@ -73,6 +73,12 @@ class JsonValue {
 	 */
 	JsonValue(const JsonObject &o);
 
+	/**
+	 * @brief Create a JsonValue that takes over the contents of a JsonObject
+	 * @param o: a JsonObject, left empty
+	 */
+	JsonValue(JsonObject &&o);
+
 	/**
 	 * @brief Create a JsonValue from a JsonArray
 	 * @param a: a JsonArray
@@ -597,6 +603,9 @@ inline JsonValue::operator JsonArray() const {
 inline JsonValue::JsonValue(const JsonObject &o) : v(o.getObject()) {
 }
 
+inline JsonValue::JsonValue(JsonObject &&o) : v(std::move(o.getObject())) {
+}
+
 inline JsonValue::JsonValue(const JsonArray &a) : v(a.getArray()) {
 }
 
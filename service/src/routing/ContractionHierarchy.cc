@@ -0,0 +1,244 @@
+#include "ContractionHierarchy.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <queue>
+#include <system_error>
+
+#include "Graph.h"
+#include "SearchWorkspace.h"
+
+using routing::ContractionHierarchy;
+using routing::Graph;
+using routing::SearchWorkspace;
+
+namespace {
+struct DynamicEdge {
+	int target;
+	int middle;
+	double weight;
+};
+
+const char magic[4] = {'C', 'H', '0', '2'};
+// Witness searches give up after settling this many nodes and keep the shortcut
+const int witnessLimit = 64;
+
+// Covers the edge lengths as well as the topology, the shortcut weights are
+// sums of them and go stale when a vertex moves
+uint64_t graphHash(const Graph &g) {
+	uint64_t h = 14695981039346656037ull;
+	auto mix = [&h](uint64_t v) {
+		h ^= v;
+		h *= 1099511628211ull;
+	};
+	for (int v : g.offsets) mix(v);
+	for (int v : g.neighbors) mix(v);
+	for (float length : g.edgeLengths) {
+		uint32_t bits;
+		std::memcpy(&bits, &length, sizeof(bits));
+		mix(bits);
+	}
+	return h;
+}
+
+class Contractor {
+   public:
+	explicit Contractor(const Graph &g) : adj(g.nodes.size()), deleted(g.nodes.size(), 0), up(g.nodes.size()) {
+		for (int n = 0; n < g.nodes.size(); n++) {
+			for (int e = g.offsets[n]; e < g.offsets[n + 1]; e++) {
+				int o = g.neighbors[e];
+				if (o != n) connect(n, o, g.edgeLengths[e], -1);
+			}
+		}
+	}
+
+	// Returns the number of shortcuts contracting v needs, adding them
+	// unless simulate is set.
+	int contract(int v, bool simulate) {
+		int shortcuts = 0;
+		auto &edges = adj[v];
+		for (int i = 0; i < edges.size(); i++) {
+			double maxVia = 0;
+			for (int j = i + 1; j < edges.size(); j++) maxVia = std::max(maxVia, edges[i].weight + edges[j].weight);
+			if (maxVia == 0) continue;
+			auto ws = witness(edges[i].target, v, maxVia);
+			for (int j = i + 1; j < edges.size(); j++) {
+				double via = edges[i].weight + edges[j].weight;
+				if (ws->getScore(edges[j].target) <= via) continue;
+				shortcuts++;
+				if (!simulate) pending.push_back({edges[i].target, edges[j].target, via});
+			}
+		}
+		if (!simulate) {
+			for (auto &s : pending) connect(s.from, s.to, s.weight, v);
+			pending.clear();
+		}
+		return shortcuts;
+	}
+
+	int priority(int v) {
+		return contract(v, true) - static_cast<int>(adj[v].size()) + deleted[v];
+	}
+
+	void remove(int v) {
+		for (auto &e : adj[v]) {
+			auto &other = adj[e.target];
+			other.erase(std::find_if(other.begin(), other.end(), [v](const DynamicEdge &o) { return o.target == v; }));
+			deleted[e.target]++;
+		}
+		up[v] = std::move(adj[v]);
+		adj[v].clear();
+	}
+
+	std::vector<std::vector<DynamicEdge>> adj;
+	std::vector<int> deleted;
+	std::vector<std::vector<DynamicEdge>> up;
+
+   private:
+	struct Shortcut {
+		int from;
+		int to;
+		double weight;
+	};
+
+	void connect(int a, int b, double weight, int middle) {
+		link(a, b, weight, middle);
+		link(b, a, weight, middle);
+	}
+
+	void link(int a, int b, double weight, int middle) {
+		for (auto &e : adj[a]) {
+			if (e.target == b) {
+				if (weight < e.weight) e = {b, middle, weight};
+				return;
+			}
+		}
+		adj[a].push_back({b, middle, weight});
+	}
+
+	SearchWorkspace::Lease witness(int source, int skip, double limit) {
+		auto ws = SearchWorkspace::borrow(adj.size());
+		auto &q = ws->frontier;
+		ws->setScore(source, 0, -1);
+		q.push_back({0, source, -1, 0});
+		for (int settled = 0; !q.empty() && settled < witnessLimit; settled++) {
+			std::pop_heap(q.begin(), q.end());
+			auto [order, n, p, d] = q.back();
+			q.pop_back();
+			if (ws->isVisited(n)) continue;
+			ws->visit(n, p);
+			if (d > limit) break;
+			for (auto &e : adj[n]) {
+				double dist = d + e.weight;
+				if (e.target == skip || dist >= ws->getScore(e.target)) continue;
+				ws->setScore(e.target, dist, n);
+				q.push_back({dist, e.target, n, dist});
+				std::push_heap(q.begin(), q.end());
+			}
+		}
+		return ws;
+	}
+
+	std::vector<Shortcut> pending;
+};
+}  // namespace
+
+ContractionHierarchy::ContractionHierarchy(const Graph &g) {
+	int size = g.nodes.size();
+	Contractor c(g);
+
+	// Lazy updates: a node's priority is recomputed when it reaches the top
+	// of the queue and it is only contracted if it is still the minimum.
+	auto q = std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>>();
+	for (int n = 0; n < size; n++) q.push({c.priority(n), n});
+	rank.assign(size, -1);
+	int next = 0;
+	while (!q.empty()) {
+		int n = q.top().second;
+		q.pop();
+		if (rank[n] != -1) continue;
+		int p = c.priority(n);
+		if (!q.empty() && p > q.top().first) {
+			q.push({p, n});
+			continue;
+		}
+		c.contract(n, false);
+		c.remove(n);
+		rank[n] = next++;
+	}
+
+	upOffsets.assign(1, 0);
+	for (int n = 0; n < size; n++) {
+		for (auto &e : c.up[n]) upEdges.push_back({e.target, e.middle, static_cast<float>(e.weight)});
+		upOffsets.push_back(upEdges.size());
+	}
+}
+
+void ContractionHierarchy::unpack(int a, int b, std::vector<int> &path) const {
+	int lo = rank[a] < rank[b] ? a : b;
+	int hi = lo == a ? b : a;
+	for (int e = upOffsets[lo]; e < upOffsets[lo + 1]; e++) {
+		if (upEdges[e].target != hi) continue;
+		int m = upEdges[e].middle;
+		if (m == -1) {
+			path.push_back(b);
+		} else {
+			unpack(a, m, path);
+			unpack(m, b, path);
+		}
+		return;
+	}
+}
+
+bool ContractionHierarchy::save(const std::string &file, const Graph &g) const {
+	// Written next to the destination and renamed, so concurrent readers
+	// never see a partial file
+	auto tmp = file + ".tmp";
+	{
+		auto f = std::ofstream(tmp, std::ios::binary);
+		if (!f.is_open()) return false;
+		int32_t nodes = rank.size();
+		int32_t edges = upEdges.size();
+		uint64_t hash = graphHash(g);
+		f.write(magic, sizeof(magic));
+		f.write(reinterpret_cast<const char *>(&nodes), sizeof(nodes));
+		f.write(reinterpret_cast<const char *>(&edges), sizeof(edges));
+		f.write(reinterpret_cast<const char *>(&hash), sizeof(hash));
+		f.write(reinterpret_cast<const char *>(rank.data()), rank.size() * sizeof(int));
+		f.write(reinterpret_cast<const char *>(upOffsets.data()), upOffsets.size() * sizeof(int));
+		f.write(reinterpret_cast<const char *>(upEdges.data()), upEdges.size() * sizeof(Edge));
+		if (!f.good()) return false;
+	}
+	auto ec = std::error_code();
+	std::filesystem::rename(tmp, file, ec);
+	return !ec;
+}
+
+bool ContractionHierarchy::load(const std::string &file, const Graph &g) {
+	auto f = std::ifstream(file, std::ios::binary);
+	if (!f.is_open()) return false;
+	char m[4];
+	int32_t nodes, edges;
+	uint64_t hash;
+	f.read(m, sizeof(m));
+	f.read(reinterpret_cast<char *>(&nodes), sizeof(nodes));
+	f.read(reinterpret_cast<char *>(&edges), sizeof(edges));
+	f.read(reinterpret_cast<char *>(&hash), sizeof(hash));
+	if (!f || !std::equal(m, m + 4, magic) || nodes != g.nodes.size() || edges < 0 || hash != graphHash(g)) {
+		return false;
+	}
+	rank.resize(nodes);
+	upOffsets.resize(nodes + 1);
+	upEdges.resize(edges);
+	f.read(reinterpret_cast<char *>(rank.data()), rank.size() * sizeof(int));
+	f.read(reinterpret_cast<char *>(upOffsets.data()), upOffsets.size() * sizeof(int));
+	f.read(reinterpret_cast<char *>(upEdges.data()), upEdges.size() * sizeof(Edge));
+	if (!f || upOffsets.back() != edges) {
+		*this = ContractionHierarchy();
+		return false;
+	}
+	return true;
+}
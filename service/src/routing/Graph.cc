@@ -1,5 +1,7 @@
 #include "Graph.h"
 
+#include <typeinfo>
+
 using routing::Graph;
 using routing::GraphNode;
 
@@ -15,7 +17,87 @@ void Graph::addEdge(int n1, int n2) {
 	adjacencyList[n1].push_back(n2);
 }
 
+void Graph::freeze() {
+	if (isFrozen()) return;
+
+	auto edges = std::vector<std::pair<int, int>>();
+	for (int n = 0; n < adjacencyList.size(); n++) {
+		for (int o : adjacencyList[n]) edges.push_back({n, o});
+	}
+	std::vector<std::vector<int>>().swap(adjacencyList);
+	freeze(edges);
+}
+
+void Graph::freeze(const std::vector<std::pair<int, int>> &edges) {
+	// Counting sort by source node keeps the order of each node's edges
+	offsets.assign(nodes.size() + 1, 0);
+	for (auto [from, to] : edges) offsets[from + 1]++;
+	for (int n = 0; n < nodes.size(); n++) offsets[n + 1] += offsets[n];
+	neighbors.resize(edges.size());
+	edgeLengths.resize(edges.size());
+	auto next = std::vector<int>(offsets.begin(), offsets.end() - 1);
+	for (auto [from, to] : edges) {
+		int e = next[from]++;
+		neighbors[e] = to;
+		edgeLengths[e] = nodes[from].getPosition().dist(nodes[to].getPosition());
+	}
+	buildIndex();
+}
+
+void Graph::buildIndex() {
+	nodeX.resize(nodes.size());
+	nodeY.resize(nodes.size());
+	nodeZ.resize(nodes.size());
+	auto positions = std::vector<Vector3>(nodes.size());
+	for (int i = 0; i < nodes.size(); i++) {
+		const Vector3 &p = nodes[i].getPosition();
+		nodeX[i] = p.x;
+		nodeY[i] = p.y;
+		nodeZ[i] = p.z;
+		positions[i] = p;
+	}
+	spatialIndex = KdTree(positions);
+}
+
+void Graph::buildLandmarks(int count) {
+	freeze();
+	landmarks = LandmarkTable(*this, count);
+}
+
+void Graph::buildHierarchy(const std::string &cacheFile) {
+	freeze();
+	if (hierarchy.load(cacheFile, *this)) return;
+	hierarchy = ContractionHierarchy(*this);
+	hierarchy.save(cacheFile, *this);
+}
+
+const routing::LandmarkTable &Graph::getLandmarks() const {
+	// Graphs are shared between sessions, the first search builds for all
+	std::call_once(landmarksBuilt, [this]() {
+		if (landmarks.empty() && isFrozen()) landmarks = LandmarkTable(*this, landmarkCount);
+	});
+	return landmarks;
+}
+
+const routing::ContractionHierarchy &Graph::getHierarchy() const {
+	std::call_once(hierarchyBuilt, [this]() {
+		if (!hierarchy.empty() || !isFrozen()) return;
+		if (!hierarchyCache.empty() && hierarchy.load(hierarchyCache, *this)) return;
+		hierarchy = ContractionHierarchy(*this);
+		if (!hierarchyCache.empty()) hierarchy.save(hierarchyCache, *this);
+	});
+	return hierarchy;
+}
+
+float Graph::distance(int n1, int n2) const {
+	float dx = nodeX[n1] - nodeX[n2];
+	float dy = nodeY[n1] - nodeY[n2];
+	float dz = nodeZ[n1] - nodeZ[n2];
+	return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
 int Graph::nearestNode(const Vector3 &pos) const {
+	if (!spatialIndex.empty()) return spatialIndex.nearest(pos);
 	int min_i = -1;
 	double min_d = INFINITY;
 	for (int i = 0; i < nodes.size(); i++) {
@@ -28,14 +110,25 @@ int Graph::nearestNode(const Vector3 &pos) const {
 	return min_i;
 }
 
+std::vector<int> Graph::nearestNodes(const Vector3 &pos, int k) const {
+	return spatialIndex.nearest(pos, k);
+}
+
+std::vector<int> Graph::nodesWithin(const Vector3 &pos, double radius) const {
+	return spatialIndex.within(pos, radius);
+}
+
 std::optional<std::vector<Vector3>> Graph::getPath(const Vector3 &start, const Vector3 &end,
                                                    const RoutingStrategy &strat) const {
-	auto n1 = nearestNode(start);
-	auto n2 = nearestNode(end);
-	auto path = strat.getPath(*this, n1, n2);
-	if (!path.has_value()) return std::nullopt;
-	auto v = path.value();
-	auto result = std::vector<Vector3>(v.size());
-	for (int i = 0; i < v.size(); i++) result[i] = nodes[v[i]].getPosition();
+	auto key = RouteCache::Key{nearestNode(start), nearestNode(end), typeid(strat)};
+	auto result = RouteCache::Path();
+	if (routeCache.find(key, result)) return result;
+	auto path = strat.getPath(*this, key.start, key.end);
+	if (path.has_value()) {
+		auto &v = path.value();
+		result.emplace(v.size());
+		for (int i = 0; i < v.size(); i++) (*result)[i] = nodes[v[i]].getPosition();
+	}
+	routeCache.insert(key, result);
 	return result;
 }
@@ -0,0 +1,41 @@
+#include "GraphRegistry.h"
+
+#include <filesystem>
+#include <mutex>
+#include <system_error>
+#include <unordered_map>
+
+#include "GraphCache.h"
+#include "OBJParser.h"
+
+using routing::Graph;
+using routing::GraphRegistry;
+
+namespace {
+struct Entry {
+	std::weak_ptr<const Graph> graph;
+	routing::SourceStamp stamp;
+};
+
+std::mutex mutex;
+std::unordered_map<std::string, Entry> graphs;
+}  // namespace
+
+std::shared_ptr<const Graph> GraphRegistry::acquire(const std::string &file) {
+	auto ec = std::error_code();
+	auto key = std::filesystem::absolute(file, ec).lexically_normal().string();
+	if (ec) key = file;
+	auto stamp = routing::sourceStamp(file);
+
+	// Held while parsing, so sessions asking for the same file at once
+	// wait for a single parse instead of each doing their own
+	auto lock = std::lock_guard(mutex);
+	std::erase_if(graphs, [](const auto &e) { return e.second.graph.expired(); });
+	auto it = graphs.find(key);
+	if (it != graphs.end() && it->second.stamp == stamp) {
+		if (auto graph = it->second.graph.lock()) return graph;
+	}
+	auto graph = std::shared_ptr<const Graph>(routing::OBJGraphParser(file));
+	if (graph) graphs[key] = {graph, stamp};
+	return graph;
+}
@@ -0,0 +1,103 @@
+#include "KdTree.h"
+
+#include <algorithm>
+#include <numeric>
+
+using routing::KdTree;
+
+KdTree::KdTree(const std::vector<Vector3> &pos) : points(pos.size()), ids(pos.size()) {
+	std::iota(ids.begin(), ids.end(), 0);
+	for (int i = 0; i < pos.size(); i++) points[i] = {pos[i].x, pos[i].y, pos[i].z};
+	build(0, ids.size(), 0);
+	// Store the points in tree order so queries walk memory linearly
+	std::vector<std::array<double, 3>> ordered(points.size());
+	for (int i = 0; i < ids.size(); i++) ordered[i] = points[ids[i]];
+	points.swap(ordered);
+}
+
+void KdTree::build(int lo, int hi, int axis) {
+	if (hi - lo <= 1) return;
+	int mid = lo + (hi - lo) / 2;
+	std::nth_element(ids.begin() + lo, ids.begin() + mid, ids.begin() + hi,
+	                 [this, axis](int a, int b) { return points[a][axis] < points[b][axis]; });
+	build(lo, mid, (axis + 1) % 3);
+	build(mid + 1, hi, (axis + 1) % 3);
+}
+
+double KdTree::distance2(int i, const Vector3 &p) const {
+	double dx = points[i][0] - p.x;
+	double dy = points[i][1] - p.y;
+	double dz = points[i][2] - p.z;
+	return dx * dx + dy * dy + dz * dz;
+}
+
+int KdTree::nearest(const Vector3 &p) const {
+	if (ids.empty()) return -1;
+	Candidate best = {INFINITY, -1};
+	nearest(0, ids.size(), 0, p, best);
+	return best.id;
+}
+
+void KdTree::nearest(int lo, int hi, int axis, const Vector3 &p, Candidate &best) const {
+	if (lo >= hi) return;
+	int mid = lo + (hi - lo) / 2;
+	Candidate c = {distance2(mid, p), ids[mid]};
+	if (c < best) best = c;
+	double diff = p[axis] - points[mid][axis];
+	int next = (axis + 1) % 3;
+	if (diff < 0) {
+		nearest(lo, mid, next, p, best);
+		if (diff * diff <= best.d2) nearest(mid + 1, hi, next, p, best);
+	} else {
+		nearest(mid + 1, hi, next, p, best);
+		if (diff * diff <= best.d2) nearest(lo, mid, next, p, best);
+	}
+}
+
+std::vector<int> KdTree::nearest(const Vector3 &p, int k) const {
+	auto heap = std::vector<Candidate>();
+	if (k <= 0) return {};
+	heap.reserve(k);
+	nearest(0, ids.size(), 0, p, k, heap);
+	std::sort_heap(heap.begin(), heap.end());
+	auto result = std::vector<int>(heap.size());
+	for (int i = 0; i < heap.size(); i++) result[i] = heap[i].id;
+	return result;
+}
+
+void KdTree::nearest(int lo, int hi, int axis, const Vector3 &p, int k, std::vector<Candidate> &heap) const {
+	if (lo >= hi) return;
+	int mid = lo + (hi - lo) / 2;
+	Candidate c = {distance2(mid, p), ids[mid]};
+	if (heap.size() < k) {
+		heap.push_back(c);
+		std::push_heap(heap.begin(), heap.end());
+	} else if (c < heap.front()) {
+		std::pop_heap(heap.begin(), heap.end());
+		heap.back() = c;
+		std::push_heap(heap.begin(), heap.end());
+	}
+	double diff = p[axis] - points[mid][axis];
+	int next = (axis + 1) % 3;
+	int nearLo = diff < 0 ? lo : mid + 1, nearHi = diff < 0 ? mid : hi;
+	int farLo = diff < 0 ? mid + 1 : lo, farHi = diff < 0 ? hi : mid;
+	nearest(nearLo, nearHi, next, p, k, heap);
+	if (heap.size() < k || diff * diff <= heap.front().d2) nearest(farLo, farHi, next, p, k, heap);
+}
+
+std::vector<int> KdTree::within(const Vector3 &p, double radius) const {
+	auto result = std::vector<int>();
+	within(0, ids.size(), 0, p, radius * radius, result);
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+void KdTree::within(int lo, int hi, int axis, const Vector3 &p, double r2, std::vector<int> &result) const {
+	if (lo >= hi) return;
+	int mid = lo + (hi - lo) / 2;
+	if (distance2(mid, p) <= r2) result.push_back(ids[mid]);
+	double diff = p[axis] - points[mid][axis];
+	int next = (axis + 1) % 3;
+	if (diff < 0 || diff * diff <= r2) within(lo, mid, next, p, r2, result);
+	if (diff >= 0 || diff * diff <= r2) within(mid + 1, hi, next, p, r2, result);
+}
@@ -0,0 +1,85 @@
+#include "LandmarkTable.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Graph.h"
+
+using routing::Graph;
+using routing::LandmarkTable;
+
+namespace {
+std::vector<double> shortestDistances(const Graph &g, int source) {
+	struct t {
+		double distance;
+		int node;
+		bool operator<(const t &o) const {
+			return distance > o.distance;
+		}
+	};
+	auto dist = std::vector<double>(g.nodes.size(), INFINITY);
+	auto q = std::vector<t>();
+	dist[source] = 0;
+	q.push_back({0, source});
+	while (!q.empty()) {
+		std::pop_heap(q.begin(), q.end());
+		auto [d, n] = q.back();
+		q.pop_back();
+		if (d > dist[n]) continue;
+		for (int e = g.offsets[n]; e < g.offsets[n + 1]; e++) {
+			int o = g.neighbors[e];
+			double nd = d + g.edgeLengths[e];
+			if (nd < dist[o]) {
+				dist[o] = nd;
+				q.push_back({nd, o});
+				std::push_heap(q.begin(), q.end());
+			}
+		}
+	}
+	return dist;
+}
+}  // namespace
+
+LandmarkTable::LandmarkTable(const Graph &g, int count) {
+	int size = g.nodes.size();
+	int start = -1;
+	for (int n = 0; n < size && start == -1; n++) {
+		if (g.offsets[n + 1] > g.offsets[n]) start = n;
+	}
+	if (start == -1 || count <= 0) return;
+
+	// Farthest-point selection: each landmark is the reachable node farthest
+	// from all landmarks chosen so far, seeded by the node farthest from start.
+	auto tables = std::vector<std::vector<double>>();
+	auto closest = shortestDistances(g, start);
+	for (int l = 0; l < count; l++) {
+		int next = -1;
+		for (int n = 0; n < size; n++) {
+			if (std::isfinite(closest[n]) && (next == -1 || closest[n] > closest[next])) next = n;
+		}
+		if (next == -1 || closest[next] == 0) break;
+		landmarks.push_back(next);
+		tables.push_back(shortestDistances(g, next));
+		if (l == 0) closest = tables.back();
+		for (int n = 0; n < size; n++) closest[n] = std::min(closest[n], tables.back()[n]);
+	}
+
+	int k = landmarks.size();
+	distances.resize(size * k);
+	for (int n = 0; n < size; n++) {
+		for (int l = 0; l < k; l++) distances[n * k + l] = tables[l][n];
+	}
+}
+
+double LandmarkTable::lowerBound(int n1, int n2) const {
+	int k = landmarks.size();
+	if (k == 0) return 0;
+	const float *d1 = &distances[n1 * k];
+	const float *d2 = &distances[n2 * k];
+	float bound = 0;
+	for (int l = 0; l < k; l++) {
+		// Landmarks in another component say nothing about this pair
+		if (std::isfinite(d1[l]) && std::isfinite(d2[l])) bound = std::max(bound, std::abs(d1[l] - d2[l]));
+	}
+	return bound;
+}
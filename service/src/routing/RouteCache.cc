@@ -0,0 +1,66 @@
+#include "RouteCache.h"
+
+using routing::RouteCache;
+
+bool RouteCache::find(const Key &key, Path &path) {
+	auto lock = std::lock_guard(mutex);
+	auto it = index.find(key);
+	if (it == index.end()) {
+		misses++;
+		return false;
+	}
+	hits++;
+	entries.splice(entries.begin(), entries, it->second);
+	path = it->second->second;
+	return true;
+}
+
+void RouteCache::insert(const Key &key, const Path &path) {
+	auto lock = std::lock_guard(mutex);
+	if (capacity == 0) return;
+	auto it = index.find(key);
+	if (it != index.end()) {
+		it->second->second = path;
+		entries.splice(entries.begin(), entries, it->second);
+		return;
+	}
+	entries.emplace_front(key, path);
+	index.emplace(key, entries.begin());
+	trim();
+}
+
+void RouteCache::clear() {
+	auto lock = std::lock_guard(mutex);
+	entries.clear();
+	index.clear();
+	hits = 0;
+	misses = 0;
+}
+
+void RouteCache::setCapacity(size_t c) {
+	auto lock = std::lock_guard(mutex);
+	capacity = c;
+	trim();
+}
+
+size_t RouteCache::size() const {
+	auto lock = std::lock_guard(mutex);
+	return entries.size();
+}
+
+size_t RouteCache::getHits() const {
+	auto lock = std::lock_guard(mutex);
+	return hits;
+}
+
+size_t RouteCache::getMisses() const {
+	auto lock = std::lock_guard(mutex);
+	return misses;
+}
+
+void RouteCache::trim() {
+	while (entries.size() > capacity) {
+		index.erase(entries.back().first);
+		entries.pop_back();
+	}
+}
@@ -0,0 +1,49 @@
+#include "SearchWorkspace.h"
+
+#include <algorithm>
+
+using routing::SearchWorkspace;
+
+namespace {
+thread_local std::vector<std::unique_ptr<SearchWorkspace>> pool;
+}
+
+SearchWorkspace::Lease::~Lease() {
+	if (ws) pool.push_back(std::move(ws));
+}
+
+SearchWorkspace::Lease SearchWorkspace::borrow(int size) {
+	std::unique_ptr<SearchWorkspace> ws;
+	if (pool.empty()) {
+		ws = std::make_unique<SearchWorkspace>();
+	} else {
+		ws = std::move(pool.back());
+		pool.pop_back();
+	}
+	ws->reset(size);
+	return Lease(std::move(ws));
+}
+
+void SearchWorkspace::reset(int size) {
+	if (visitedStamp.size() < size) {
+		visitedStamp.resize(size, 0);
+		scoreStamp.resize(size, 0);
+		parents.resize(size);
+		scores.resize(size);
+	}
+	frontier.clear();
+	if (++generation == 0) {
+		// Stamps wrapped around, so old marks would look current again
+		std::fill(visitedStamp.begin(), visitedStamp.end(), 0);
+		std::fill(scoreStamp.begin(), scoreStamp.end(), 0);
+		generation = 1;
+	}
+}
+
+std::optional<std::vector<int>> SearchWorkspace::tracePath(int end) const {
+	if (end < 0 || end >= visitedStamp.size() || !(isVisited(end) || isReached(end))) return std::nullopt;
+	auto path = std::vector<int>();
+	for (int n = end; n != -1; n = parents[n]) path.push_back(n);
+	std::reverse(path.begin(), path.end());
+	return path;
+}
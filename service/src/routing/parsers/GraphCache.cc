@@ -0,0 +1,135 @@
+#include "GraphCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#include "MappedFile.h"
+
+namespace {
+const char magic[4] = {'G', 'R', 'P', '1'};
+
+// Fixed size header, followed by the node positions (x, y, z doubles),
+// offsets, neighbors, edge lengths, landmark ids and landmark distances.
+struct Header {
+	char magic[4];
+	int32_t nodes;
+	int32_t edges;
+	int32_t landmarks;
+	uint64_t sourceSize;
+	int64_t sourceMtime;
+};
+
+template <typename T>
+void writeArray(std::ofstream &f, const std::vector<T> &v) {
+	f.write(reinterpret_cast<const char *>(v.data()), v.size() * sizeof(T));
+}
+
+// Whether the arrays read from a cache describe a graph the searches can
+// walk without leaving them
+bool isConsistent(const routing::Graph &g) {
+	int nodes = g.nodes.size();
+	if (g.offsets.front() != 0 || g.offsets.back() != g.neighbors.size()) return false;
+	for (int n = 0; n < nodes; n++) {
+		if (g.offsets[n] > g.offsets[n + 1]) return false;
+	}
+	for (int to : g.neighbors) {
+		if (to < 0 || to >= nodes) return false;
+	}
+	for (int l : g.landmarks.landmarks) {
+		if (l < 0 || l >= nodes) return false;
+	}
+	return true;
+}
+
+template <typename T>
+void readArray(const char *&p, std::vector<T> &v, size_t count) {
+	v.resize(count);
+	std::memcpy(v.data(), p, count * sizeof(T));
+	p += count * sizeof(T);
+}
+}  // namespace
+
+namespace routing {
+SourceStamp sourceStamp(const std::string &file) {
+	auto ec = std::error_code();
+	auto size = std::filesystem::file_size(file, ec);
+	if (ec) return {};
+	auto time = std::filesystem::last_write_time(file, ec);
+	if (ec) return {};
+	return {size, static_cast<int64_t>(time.time_since_epoch().count())};
+}
+
+Graph *readGraphCache(const std::string &file, const SourceStamp &stamp) {
+	auto m = MappedFile(file);
+	if (!m.isOpen() || m.size() < sizeof(Header)) return nullptr;
+	Header h;
+	std::memcpy(&h, m.begin(), sizeof(h));
+	if (std::memcmp(h.magic, magic, sizeof(magic)) != 0 || SourceStamp{h.sourceSize, h.sourceMtime} != stamp) {
+		return nullptr;
+	}
+	if (h.nodes < 0 || h.edges < 0 || h.landmarks < 0) return nullptr;
+	size_t nodes = h.nodes, edges = h.edges, landmarks = h.landmarks;
+	size_t expected = sizeof(Header) + nodes * 3 * sizeof(double) + (nodes + 1) * sizeof(int) +
+	                  edges * (sizeof(int) + sizeof(float)) + landmarks * sizeof(int) +
+	                  nodes * landmarks * sizeof(float);
+	if (m.size() != expected) return nullptr;
+
+	const char *p = m.begin() + sizeof(Header);
+	auto positions = std::vector<double>();
+	readArray(p, positions, nodes * 3);
+	Graph *g = new Graph();
+	g->nodes.reserve(nodes);
+	for (int i = 0; i < nodes; i++) {
+		g->nodes.push_back(GraphNode(i, {positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]}));
+	}
+	readArray(p, g->offsets, nodes + 1);
+	readArray(p, g->neighbors, edges);
+	readArray(p, g->edgeLengths, edges);
+	readArray(p, g->landmarks.landmarks, landmarks);
+	readArray(p, g->landmarks.distances, nodes * landmarks);
+	if (!isConsistent(*g)) {
+		delete g;
+		return nullptr;
+	}
+	g->buildIndex();
+	return g;
+}
+
+bool writeGraphCache(const Graph &g, const std::string &file, const SourceStamp &stamp) {
+	if (!g.isFrozen()) return false;
+	// Written next to the destination and renamed, so concurrent readers
+	// never see a partial file
+	auto tmp = file + ".tmp";
+	{
+		auto f = std::ofstream(tmp, std::ios::binary);
+		if (!f.is_open()) return false;
+		Header h;
+		std::memcpy(h.magic, magic, sizeof(magic));
+		h.nodes = g.nodes.size();
+		h.edges = g.neighbors.size();
+		h.landmarks = g.landmarks.landmarks.size();
+		h.sourceSize = stamp.size;
+		h.sourceMtime = stamp.mtime;
+		f.write(reinterpret_cast<const char *>(&h), sizeof(h));
+		auto positions = std::vector<double>();
+		positions.reserve(g.nodes.size() * 3);
+		for (auto &n : g.nodes) {
+			positions.push_back(n.getPosition().x);
+			positions.push_back(n.getPosition().y);
+			positions.push_back(n.getPosition().z);
+		}
+		writeArray(f, positions);
+		writeArray(f, g.offsets);
+		writeArray(f, g.neighbors);
+		writeArray(f, g.edgeLengths);
+		writeArray(f, g.landmarks.landmarks);
+		writeArray(f, g.landmarks.distances);
+		if (!f.good()) return false;
+	}
+	auto ec = std::error_code();
+	std::filesystem::rename(tmp, file, ec);
+	return !ec;
+}
+}  // namespace routing
@@ -0,0 +1,28 @@
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using routing::MappedFile;
+
+MappedFile::MappedFile(const std::string &file) {
+	int fd = open(file.c_str(), O_RDONLY);
+	if (fd < 0) return;
+	struct stat st;
+	// Empty files cannot be mapped, they are treated as missing
+	if (fstat(fd, &st) == 0 && st.st_size > 0) {
+		void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p != MAP_FAILED) {
+			data = static_cast<const char *>(p);
+			length = st.st_size;
+			madvise(p, length, MADV_SEQUENTIAL);
+		}
+	}
+	close(fd);
+}
+
+MappedFile::~MappedFile() {
+	if (data) munmap(const_cast<char *>(data), length);
+}
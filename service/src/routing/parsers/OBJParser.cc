@@ -1,33 +1,125 @@
 #include "OBJParser.h"
 
-#include <fstream>
+#include <algorithm>
+#include <charconv>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "GraphCache.h"
+#include "MappedFile.h"
 
 using routing::Graph;
 
+namespace {
+// Files smaller than this are parsed on the calling thread
+const size_t chunkSize = 4 << 20;
+
+struct Chunk {
+	std::vector<Vector3> vertices;
+	// OBJ vertex indices, which start at 1
+	std::vector<std::pair<int, int>> lines;
+};
+
+bool isSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char *skipSpace(const char *p, const char *end) {
+	while (p < end && isSpace(*p)) p++;
+	return p;
+}
+
+// Parses the v and l statements of the complete lines in [begin, end)
+void parseChunk(const char *begin, const char *end, Chunk &chunk) {
+	const char *p = begin;
+	while (p < end) {
+		const char *eol = std::find(p, end, '\n');
+		p = skipSpace(p, eol);
+		if (p + 1 < eol && isSpace(p[1]) && (p[0] == 'v' || p[0] == 'l')) {
+			char type = p[0];
+			p += 2;
+			if (type == 'v') {
+				double c[3];
+				int read = 0;
+				for (; read < 3; read++) {
+					p = skipSpace(p, eol);
+					auto [next, ec] = std::from_chars(p, eol, c[read]);
+					if (ec != std::errc()) break;
+					p = next;
+				}
+				if (read == 3) chunk.vertices.push_back({c[0], c[1], c[2]});
+			} else {
+				// A polyline connects each vertex to the next, ignoring any /vt suffix
+				int prev = 0;
+				while (true) {
+					p = skipSpace(p, eol);
+					int n;
+					auto [next, ec] = std::from_chars(p, eol, n);
+					if (ec != std::errc()) break;
+					p = next;
+					while (p < eol && !isSpace(*p)) p++;
+					if (prev != 0) chunk.lines.push_back({prev, n});
+					prev = n;
+				}
+			}
+		}
+		p = eol + 1;
+	}
+}
+}  // namespace
+
 namespace routing {
 const Graph *OBJGraphParser(std::string file) {
 	if (!file.ends_with(".obj")) return nullptr;
-	auto f = std::fstream(file);
-	Graph *g = new Graph();
-	g->addNode({-1000, -1000, -1000});
-	if (f.is_open()) {
-		char c;
-		while (f >> c) {
-			switch (c) {
-				case 'v':
-					double x, y, z;
-					f >> x >> y >> z;
-					g->addNode({x, y, z});
-					break;
-				case 'l':
-					int n1, n2;
-					f >> n1 >> n2;
-					g->addEdge(n1, n2);
-					g->addEdge(n2, n1);
-					break;
+	auto stamp = sourceStamp(file);
+	auto cacheFile = file + ".graph";
+	if (Graph *cached = readGraphCache(cacheFile, stamp)) {
+		cached->hierarchyCache = file + ".ch";
+		return cached;
+	}
+
+	auto chunks = std::vector<Chunk>(1);
+	{
+		auto m = MappedFile(file);
+		if (m.isOpen()) {
+			size_t cores = std::thread::hardware_concurrency();
+			int threads = std::max<int>(1, std::min(cores, m.size() / chunkSize));
+			chunks.resize(threads);
+			// Split on line boundaries so every statement lands in one chunk
+			auto bounds = std::vector<const char *>{m.begin()};
+			for (int i = 1; i < threads; i++) {
+				const char *b = std::max(bounds.back(), m.begin() + m.size() * i / threads);
+				bounds.push_back(std::min(std::find(b, m.end(), '\n') + 1, m.end()));
+			}
+			bounds.push_back(m.end());
+			auto workers = std::vector<std::thread>();
+			for (int i = 1; i < threads; i++) {
+				workers.emplace_back(parseChunk, bounds[i], bounds[i + 1], std::ref(chunks[i]));
 			}
+			parseChunk(bounds[0], bounds[1], chunks[0]);
+			for (auto &w : workers) w.join();
+		}
+	}
+
+	Graph *g = new Graph();
+	// Node 0 is a placeholder so the 1-based OBJ indices can be used as ids
+	g->nodes.push_back(GraphNode(0, {-1000, -1000, -1000}));
+	auto edges = std::vector<std::pair<int, int>>();
+	for (auto &c : chunks) {
+		for (auto &v : c.vertices) g->nodes.push_back(GraphNode(g->nodes.size(), v));
+	}
+	for (auto &c : chunks) {
+		for (auto [n1, n2] : c.lines) {
+			if (n1 <= 0 || n2 <= 0 || n1 >= g->nodes.size() || n2 >= g->nodes.size()) continue;
+			edges.push_back({n1, n2});
+			edges.push_back({n2, n1});
 		}
 	}
+	g->freeze(edges);
+	if (stamp.size > 0) writeGraphCache(*g, cacheFile, stamp);
+	// Landmarks and the hierarchy are built when a search first needs them
+	g->hierarchyCache = file + ".ch";
 	return g;
 }
 }  // namespace routing
@@ -1,49 +1,36 @@
 #include "AStar.h"
 
 #include <algorithm>
-#include <map>
-#include <queue>
-#include <set>
+
+#include "SearchWorkspace.h"
 
 using routing::AStar;
+using routing::SearchWorkspace;
 
 std::optional<std::vector<int>> AStar::getPath(const Graph &g, int start, int end) const {
-	struct t {
-		double order;
-		struct {
-			int node;
-			int parent;
-			double distance;
-		} info;
-		bool operator<(const t &o) const {
-			return order > o.order;
-		}
+	auto ws = SearchWorkspace::borrow(g.nodes.size());
+	auto &q = ws->frontier;
+	auto push = [&q](const SearchWorkspace::Entry &e) {
+		q.push_back(e);
+		std::push_heap(q.begin(), q.end());
 	};
-	auto q = std::priority_queue<t>();
-	auto v = std::set<int>();
-	auto parents = std::map<int, int>();
-	q.push({0, {start, -1, 0}});
+	ws->setScore(start, 0, -1);
+	push({0, start, -1, 0});
 	while (!q.empty()) {
-		auto [n, p, d] = q.top().info;
-		q.pop();
-		if (v.contains(n)) continue;
-		v.insert(n);
-		parents[n] = p;
+		std::pop_heap(q.begin(), q.end());
+		auto [order, n, p, d] = q.back();
+		q.pop_back();
+		if (ws->isVisited(n)) continue;
+		ws->visit(n, p);
 		if (n == end) break;
-		auto n1 = g.nodes[n];
-		for (auto &o : g.adjacencyList[n]) {
-			auto n2 = g.nodes[o];
-			auto dist = n1.getPosition().dist(n2.getPosition());
-			q.push({d + dist + heuristic(n2, g.nodes[end]), {o, n, d + dist}});
+		for (int e = g.offsets[n]; e < g.offsets[n + 1]; e++) {
+			int o = g.neighbors[e];
+			if (ws->isVisited(o)) continue;
+			double dist = d + g.edgeLengths[e];
+			if (dist >= ws->getScore(o)) continue;
+			ws->setScore(o, dist, n);
+			push({dist + heuristic(g, o, end), o, n, dist});
 		}
 	}
-	auto n = end;
-	auto path = std::vector<int>();
-	while (n != -1) {
-		path.push_back(n);
-		if (!parents.contains(n)) return std::nullopt;
-		n = parents[n];
-	}
-	std::reverse(path.begin(), path.end());
-	return path;
+	return ws->tracePath(end);
 }
@@ -0,0 +1,58 @@
+#include "BidirectionalAStar.h"
+
+#include <algorithm>
+
+#include "SearchWorkspace.h"
+
+using routing::BidirectionalAStar;
+using routing::SearchWorkspace;
+
+std::optional<std::vector<int>> BidirectionalAStar::getPath(const Graph &g, int start, int end) const {
+	auto fw = SearchWorkspace::borrow(g.nodes.size());
+	auto bw = SearchWorkspace::borrow(g.nodes.size());
+	// Forward keys use p(n), backward keys use -p(n)
+	auto potential = [&g, start, end](int n) { return (g.distance(n, end) - g.distance(n, start)) / 2.0; };
+	auto push = [](std::vector<SearchWorkspace::Entry> &q, const SearchWorkspace::Entry &e) {
+		q.push_back(e);
+		std::push_heap(q.begin(), q.end());
+	};
+
+	fw->setScore(start, 0, -1);
+	push(fw->frontier, {potential(start), start, -1, 0});
+	bw->setScore(end, 0, -1);
+	push(bw->frontier, {-potential(end), end, -1, 0});
+
+	double best = start == end ? 0 : INFINITY;
+	int meet = start == end ? start : -1;
+	while (!fw->frontier.empty() && !bw->frontier.empty()) {
+		if (fw->frontier.front().order + bw->frontier.front().order >= best) break;
+
+		bool forward = fw->frontier.front().order <= bw->frontier.front().order;
+		SearchWorkspace &ws = forward ? *fw : *bw;
+		SearchWorkspace &other = forward ? *bw : *fw;
+		auto &q = ws.frontier;
+		std::pop_heap(q.begin(), q.end());
+		auto [order, n, p, d] = q.back();
+		q.pop_back();
+		if (ws.isVisited(n)) continue;
+		ws.visit(n, p);
+		for (int e = g.offsets[n]; e < g.offsets[n + 1]; e++) {
+			int o = g.neighbors[e];
+			if (ws.isVisited(o)) continue;
+			double dist = d + g.edgeLengths[e];
+			if (dist >= ws.getScore(o)) continue;
+			ws.setScore(o, dist, n);
+			push(q, {dist + (forward ? potential(o) : -potential(o)), o, n, dist});
+			if (other.isReached(o) && dist + other.getScore(o) < best) {
+				best = dist + other.getScore(o);
+				meet = o;
+			}
+		}
+	}
+	if (meet == -1) return std::nullopt;
+
+	auto path = fw->tracePath(meet).value();
+	auto back = bw->tracePath(meet).value();
+	path.insert(path.end(), back.rbegin() + 1, back.rend());
+	return path;
+}
@@ -1,37 +1,23 @@
 #include "BreadthFirstSearch.h"
 
-#include <algorithm>
-#include <map>
-#include <queue>
-#include <set>
+#include "SearchWorkspace.h"
 
 using routing::BreadthFirstSearch;
+using routing::SearchWorkspace;
 
 std::optional<std::vector<int>> BreadthFirstSearch::getPath(const Graph &g, int start, int end) const {
-	struct t {
-		int node;
-		int parent;
-	};
-	auto q = std::queue<t>();
-	auto v = std::set<int>();
-	auto parents = std::map<int, int>();
-	q.push({start, -1});
-	while (!q.empty()) {
-		auto [n, p] = q.front();
-		q.pop();
-		if (v.contains(n)) continue;
-		v.insert(n);
-		parents[n] = p;
+	auto ws = SearchWorkspace::borrow(g.nodes.size());
+	auto &q = ws->frontier;
+	q.push_back({0, start, -1, 0});
+	for (size_t head = 0; head < q.size(); head++) {
+		auto [order, n, p, d] = q[head];
+		if (ws->isVisited(n)) continue;
+		ws->visit(n, p);
 		if (n == end) break;
-		for (auto &o : g.adjacencyList[n]) q.push({o, n});
+		for (int e = g.offsets[n]; e < g.offsets[n + 1]; e++) {
+			int o = g.neighbors[e];
+			if (!ws->isVisited(o)) q.push_back({0, o, n, 0});
+		}
 	}
-	auto n = end;
-	auto path = std::vector<int>();
-	while (n != -1) {
-		path.push_back(n);
-		if (!parents.contains(n)) return std::nullopt;
-		n = parents[n];
-	}
-	std::reverse(path.begin(), path.end());
-	return path;
+	return ws->tracePath(end);
 }
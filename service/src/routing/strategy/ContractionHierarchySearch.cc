@@ -0,0 +1,66 @@
+#include "ContractionHierarchySearch.h"
+
+#include <algorithm>
+
+#include "Dijkstra.h"
+#include "SearchWorkspace.h"
+
+using routing::ContractionHierarchySearch;
+using routing::SearchWorkspace;
+
+std::optional<std::vector<int>> ContractionHierarchySearch::getPath(const Graph &g, int start, int end) const {
+	const ContractionHierarchy &ch = g.getHierarchy();
+	if (ch.empty()) return Dijkstra().getPath(g, start, end);
+
+	auto fw = SearchWorkspace::borrow(g.nodes.size());
+	auto bw = SearchWorkspace::borrow(g.nodes.size());
+	auto push = [](std::vector<SearchWorkspace::Entry> &q, const SearchWorkspace::Entry &e) {
+		q.push_back(e);
+		std::push_heap(q.begin(), q.end());
+	};
+
+	fw->setScore(start, 0, -1);
+	push(fw->frontier, {0, start, -1, 0});
+	bw->setScore(end, 0, -1);
+	push(bw->frontier, {0, end, -1, 0});
+
+	double best = INFINITY;
+	int meet = -1;
+	while (!fw->frontier.empty() || !bw->frontier.empty()) {
+		auto &fq = fw->frontier;
+		auto &bq = bw->frontier;
+		bool forward = bq.empty() || (!fq.empty() && fq.front().order <= bq.front().order);
+		SearchWorkspace &ws = forward ? *fw : *bw;
+		SearchWorkspace &other = forward ? *bw : *fw;
+		auto &q = ws.frontier;
+		// Neither side can improve on best once its closest node is this far
+		if (q.front().order >= best) {
+			q.clear();
+			continue;
+		}
+		std::pop_heap(q.begin(), q.end());
+		auto [order, n, p, d] = q.back();
+		q.pop_back();
+		if (ws.isVisited(n)) continue;
+		ws.visit(n, p);
+		if (other.isReached(n) && d + other.getScore(n) < best) {
+			best = d + other.getScore(n);
+			meet = n;
+		}
+		for (int e = ch.upOffsets[n]; e < ch.upOffsets[n + 1]; e++) {
+			int o = ch.upEdges[e].target;
+			double dist = d + ch.upEdges[e].weight;
+			if (dist >= ws.getScore(o)) continue;
+			ws.setScore(o, dist, n);
+			push(q, {dist, o, n, dist});
+		}
+	}
+	if (meet == -1) return std::nullopt;
+
+	auto up = fw->tracePath(meet).value();
+	auto down = bw->tracePath(meet).value();
+	up.insert(up.end(), down.rbegin() + 1, down.rend());
+	auto path = std::vector<int>{start};
+	for (int i = 1; i < up.size(); i++) ch.unpack(up[i - 1], up[i], path);
+	return path;
+}
@@ -1,37 +1,24 @@
 #include "DepthFirstSearch.h"
 
-#include <algorithm>
-#include <map>
-#include <set>
-#include <stack>
+#include "SearchWorkspace.h"
 
 using routing::DepthFirstSearch;
+using routing::SearchWorkspace;
 
 std::optional<std::vector<int>> DepthFirstSearch::getPath(const Graph &g, int start, int end) const {
-	struct t {
-		int node;
-		int parent;
-	};
-	auto s = std::stack<t>();
-	auto v = std::set<int>();
-	auto parents = std::map<int, int>();
-	s.push({start, -1});
+	auto ws = SearchWorkspace::borrow(g.nodes.size());
+	auto &s = ws->frontier;
+	s.push_back({0, start, -1, 0});
 	while (!s.empty()) {
-		auto [n, p] = s.top();
-		s.pop();
-		if (v.contains(n)) continue;
-		v.insert(n);
-		parents[n] = p;
+		auto [order, n, p, d] = s.back();
+		s.pop_back();
+		if (ws->isVisited(n)) continue;
+		ws->visit(n, p);
 		if (n == end) break;
-		for (auto &o : g.adjacencyList[n]) s.push({o, n});
+		for (int e = g.offsets[n]; e < g.offsets[n + 1]; e++) {
+			int o = g.neighbors[e];
+			if (!ws->isVisited(o)) s.push_back({0, o, n, 0});
+		}
 	}
-	auto n = end;
-	auto path = std::vector<int>();
-	while (n != -1) {
-		path.push_back(n);
-		if (!parents.contains(n)) return std::nullopt;
-		n = parents[n];
-	}
-	std::reverse(path.begin(), path.end());
-	return path;
+	return ws->tracePath(end);
 }
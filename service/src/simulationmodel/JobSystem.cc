@@ -0,0 +1,93 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+JobSystem::JobSystem(int threads) {
+	for (int i = 1; i < threads; i++) workers.emplace_back(&JobSystem::work, this);
+}
+
+JobSystem::~JobSystem() {
+	waitWhile([this]() { return !background.empty() || running > 0; });
+	{
+		auto lock = std::lock_guard(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (auto &w : workers) w.join();
+}
+
+void JobSystem::submit(Job job) {
+	{
+		auto lock = std::lock_guard(mutex);
+		background.push_back(std::move(job));
+	}
+	wake.notify_one();
+}
+
+bool JobSystem::runChunk(Batch &batch, std::unique_lock<std::mutex> &lock) {
+	if (batch.next == batch.chunks) return false;
+	size_t begin = batch.next++ * batch.grain;
+	// Nobody looks for the batch once its last chunk is handed out
+	if (batch.next == batch.chunks) std::erase(batches, &batch);
+	lock.unlock();
+	(*batch.fn)(begin, std::min(batch.count, begin + batch.grain));
+	lock.lock();
+	// Notified under the lock, the caller may destroy the batch once it wakes
+	if (++batch.done == batch.chunks) batch.finished.notify_all();
+	return true;
+}
+
+void JobSystem::runBackground(std::unique_lock<std::mutex> &lock) {
+	Job job = std::move(background.front());
+	background.pop_front();
+	running++;
+	lock.unlock();
+	job();
+	lock.lock();
+	running--;
+	idle.notify_all();
+}
+
+void JobSystem::work() {
+	auto lock = std::unique_lock(mutex);
+	while (true) {
+		// Chunks first, a tick is waiting on them
+		if (!batches.empty()) {
+			runChunk(*batches.front(), lock);
+		} else if (!background.empty()) {
+			runBackground(lock);
+		} else if (stopping) {
+			return;
+		} else {
+			wake.wait(lock);
+		}
+	}
+}
+
+void JobSystem::waitWhile(const std::function<bool()> &busy) {
+	auto lock = std::unique_lock(mutex);
+	if (workers.empty()) {
+		while (busy() && !background.empty()) runBackground(lock);
+		return;
+	}
+	idle.wait(lock, [&busy]() { return !busy(); });
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const RangeJob &fn) {
+	if (count == 0) return;
+	grain = std::max<size_t>(grain, 1);
+	size_t chunks = (count + grain - 1) / grain;
+	if (workers.empty() || chunks == 1) {
+		for (size_t begin = 0; begin < count; begin += grain) fn(begin, std::min(count, begin + grain));
+		return;
+	}
+	Batch batch{count, grain, chunks, &fn};
+	auto lock = std::unique_lock(mutex);
+	batches.push_back(&batch);
+	wake.notify_all();
+	// Work on the loop's own chunks, then sleep until the helpers are done
+	// with the ones they took
+	while (runChunk(batch, lock)) {
+	}
+	batch.finished.wait(lock, [&batch]() { return batch.done == batch.chunks; });
+}
@@ -0,0 +1,86 @@
+#include "MotionStore.h"
+
+#include <algorithm>
+#include <cmath>
+
+MotionStore::Handle MotionStore::add(const Vector3 &position, const Vector3 &direction, double s) {
+	Handle h;
+	if (freeHandles.empty()) {
+		h = slots.size();
+		slots.push_back(-1);
+	} else {
+		h = freeHandles.back();
+		freeHandles.pop_back();
+	}
+	slots[h] = owners.size();
+	owners.push_back(h);
+	px.push_back(position.x);
+	py.push_back(position.y);
+	pz.push_back(position.z);
+	dx.push_back(direction.x);
+	dy.push_back(direction.y);
+	dz.push_back(direction.z);
+	speed.push_back(s);
+	tx.push_back(0);
+	ty.push_back(0);
+	tz.push_back(0);
+	driven.push_back(0);
+	return h;
+}
+
+void MotionStore::remove(Handle h) {
+	// Move the last slot into the freed one to keep the arrays dense
+	int i = slots[h];
+	int last = owners.size() - 1;
+	for (std::vector<double> *a : {&px, &py, &pz, &dx, &dy, &dz, &speed, &tx, &ty, &tz}) {
+		(*a)[i] = a->back();
+		a->pop_back();
+	}
+	driven[i] = driven[last];
+	driven.pop_back();
+	owners[i] = owners[last];
+	owners.pop_back();
+	if (i != last) slots[owners[i]] = i;
+	slots[h] = -1;
+	freeHandles.push_back(h);
+}
+
+void MotionStore::integrate(double dt, size_t begin, size_t end) {
+	const double eps = 0.0000001;
+	size_t n = std::min(end, owners.size());
+	// Raw pointers keep the loop free of calls even in unoptimized builds
+	double *pX = px.data(), *pY = py.data(), *pZ = pz.data();
+	double *dX = dx.data(), *dY = dy.data(), *dZ = dz.data();
+	const double *tX = tx.data(), *tY = ty.data(), *tZ = tz.data(), *v = speed.data();
+	uint8_t *d = driven.data();
+	for (size_t i = begin; i < n; i++) {
+		if (!d[i]) continue;
+		d[i] = 0;
+		// Same steps as Vector3::unit, so results match PathStrategy moving
+		// the entity itself
+		double x = tX[i] - pX[i];
+		double y = tY[i] - pY[i];
+		double z = tZ[i] - pZ[i];
+		double m = std::sqrt(x * x + y * y + z * z);
+		if (m >= eps) {
+			double inv = 1 / m;
+			x *= inv;
+			y *= inv;
+			z *= inv;
+		}
+		pX[i] += x * v[i] * dt;
+		pY[i] += y * v[i] * dt;
+		pZ[i] += z * v[i] * dt;
+		dX[i] = x;
+		dY[i] = y;
+		dZ[i] = z;
+	}
+}
+
+void MotionStore::settle() {
+	for (auto [h, carrier] : followers) {
+		setPosition(h, getPosition(carrier));
+		setDirection(h, getDirection(carrier));
+	}
+	followers.clear();
+}
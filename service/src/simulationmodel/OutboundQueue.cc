@@ -0,0 +1,26 @@
+#include "OutboundQueue.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+void OutboundQueue::push(const std::string &data, bool binary) {
+	if (count == slots.size()) {
+		// Full, unroll the ring into a bigger one with the oldest message first
+		std::vector<Buffer> grown(std::max<size_t>(8, slots.size() * 2));
+		for (size_t i = 0; i < count; i++) grown[i] = std::move(slots[(head + i) % slots.size()]);
+		slots = std::move(grown);
+		head = 0;
+	}
+	Buffer &slot = slots[(head + count) % slots.size()];
+	count++;
+	if (slot.bytes.size() < LWS_PRE + data.size()) slot.bytes.resize(LWS_PRE + data.size());
+	slot.length = data.size();
+	slot.binary = binary;
+	std::memcpy(slot.payload(), data.data(), data.size());
+}
+
+void OutboundQueue::pop(size_t n) {
+	head = (head + n) % slots.size();
+	count -= n;
+}
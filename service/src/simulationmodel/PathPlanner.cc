@@ -0,0 +1,26 @@
+#include "PathPlanner.h"
+
+PathPlanner::PathPlanner(JobSystem &jobs) : jobs(jobs) {
+}
+
+PathPlanner::~PathPlanner() {
+	drain();
+}
+
+std::future<PathPlanner::Path> PathPlanner::plan(const routing::Graph *graph, Vector3 start, Vector3 end,
+                                                 std::shared_ptr<const routing::RoutingStrategy> strategy) {
+	auto task = std::make_shared<std::packaged_task<Path()>>([graph, start, end, strategy]() {
+		return graph->getPath(start, end, *strategy);
+	});
+	auto result = task->get_future();
+	outstanding++;
+	jobs.submit([this, task]() {
+		(*task)();
+		outstanding--;
+	});
+	return result;
+}
+
+void PathPlanner::drain() {
+	jobs.waitWhile([this]() { return outstanding > 0; });
+}
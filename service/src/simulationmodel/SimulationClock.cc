@@ -0,0 +1,32 @@
+#include "SimulationClock.h"
+
+#include <algorithm>
+
+SimulationClock::SimulationClock(double rate, int maxSteps)
+    : step(1.0 / std::max(rate, 1.0)), maxSteps(std::max(maxSteps, 1)), last(Clock::now()) {
+}
+
+int SimulationClock::advance(Clock::time_point now) {
+	std::chrono::duration<double> elapsed = now - last;
+	last = now;
+	accumulator += std::max(elapsed.count(), 0.0) * speed;
+	int steps = accumulator / step;
+	if (steps > maxSteps) {
+		steps = maxSteps;
+		accumulator = 0;
+	} else {
+		accumulator = std::max(accumulator - steps * step, 0.0);
+	}
+	tick += steps;
+	return steps;
+}
+
+SimulationClock::Clock::duration SimulationClock::untilNextStep() const {
+	// Nothing is due while paused, check back after one step of wall time
+	double wait = speed > 0 ? (step - accumulator) / speed : step;
+	return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(std::max(wait, 0.0)));
+}
+
+void SimulationClock::setSpeed(double s) {
+	speed = std::max(s, 0.0);
+}
@@ -1,6 +1,12 @@
 #include "SimulationModel.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
 #include "DroneFactory.h"
+#include "GraphRegistry.h"
 #include "HelicopterFactory.h"
 #include "HumanFactory.h"
 #include "POIFactory.h"
@@ -9,9 +15,15 @@
 #include "RechargeStationFactory.h"
 #include "RobotFactory.h"
 
-#include "DroneBatteryDecorator.h"
+namespace {
+// Notifications of the chunk of entities this thread is updating in parallel
+thread_local std::vector<std::string> *deferredNotes = nullptr;
+// Entities updated or integrated together as one piece of parallel work
+const size_t chunkSize = 256;
+}  // namespace
 
-SimulationModel::SimulationModel(IController &controller) : controller(controller) {
+SimulationModel::SimulationModel(IController &controller, JobSystem &jobs)
+    : controller(controller), jobs(jobs), planner(jobs) {
 	entityFactory.addFactory(new DroneFactory());
 	entityFactory.addFactory(new PackageFactory());
 	entityFactory.addFactory(new RobotFactory());
@@ -27,7 +39,8 @@ SimulationModel::~SimulationModel() {
 	for (auto &[id, entity] : entities) {
 		delete entity;
 	}
-	delete graph;
+	// Queued requests still search the graph
+	planner.drain();
 }
 
 IEntity *SimulationModel::createEntity(const JsonObject &entity) {
@@ -35,11 +48,71 @@ IEntity *SimulationModel::createEntity(const JsonObject &entity) {
 	JsonArray position = entity["position"];
 	std::cout << name << ": " << position << std::endl;
 
-	IEntity *myNewEntity = nullptr;
-	if (myNewEntity = entityFactory.createEntity(entity)) {
+	IEntity *myNewEntity = buildEntity(entity);
+	if (myNewEntity) {
 		// Call AddEntity to add it to the view
-		myNewEntity->linkModel(this);
 		controller.addEntity(*myNewEntity);
+	}
+	return myNewEntity;
+}
+
+std::vector<IEntity *> SimulationModel::createEntities(const JsonArray &entities) {
+	std::vector<IEntity *> created;
+	std::vector<const IEntity *> added;
+	created.reserve(entities.size());
+	added.reserve(entities.size());
+	for (int i = 0; i < entities.size(); i++) {
+		if (IEntity *entity = buildEntity(entities[i])) {
+			created.push_back(entity);
+			added.push_back(entity);
+		}
+	}
+	std::cout << "Created " << created.size() << " of " << entities.size() << " entities" << std::endl;
+	controller.addEntities(added);
+	return created;
+}
+
+bool SimulationModel::loadScene(const std::string &path, const std::string &root) {
+	auto f = std::ifstream(path);
+	std::stringstream text;
+	text << f.rdbuf();
+	picojson::value scene;
+	std::string err = picojson::parse(scene, text.str());
+	if (!f.is_open() || !err.empty() || !scene.is<picojson::array>()) {
+		std::cout << "Could not load scene " << path << " " << err << std::endl;
+		return false;
+	}
+
+	JsonArray batch;
+	std::vector<JsonObject> trips;
+	for (auto &command : scene.get<picojson::array>()) {
+		if (!command.is<picojson::object>()) continue;
+		JsonObject data = JsonValue::fromReference(command);
+		if (!data.contains("command") || !data.contains("params")) continue;
+		std::string cmd = data["command"];
+		if (cmd == "CreateEntity") {
+			batch.push(data["params"]);
+		} else if (cmd == "SetGraph") {
+			JsonObject params = data["params"];
+			std::string graphFile = params["filePath"];
+			setGraph(routing::GraphRegistry::acquire((std::filesystem::path(root) / graphFile).string()));
+		} else if (cmd == "ScheduleTrip") {
+			// The trip's robot and package have to exist first
+			trips.push_back(data["params"]);
+		}
+		// SetScene and AddMesh only concern the view
+	}
+	createEntities(batch);
+	for (const JsonObject &trip : trips) scheduleTrip(trip);
+	return true;
+}
+
+IEntity *SimulationModel::buildEntity(const JsonObject &entity) {
+	Pooled::Scope pooled(&arena);
+	IEntity *myNewEntity = entityFactory.createEntity(entity);
+	if (myNewEntity) {
+		orderChanged = true;
+		myNewEntity->linkModel(this);
 		entities[myNewEntity->getId()] = myNewEntity;
 		// Add the simulation model as a observer to myNewEntity
 		myNewEntity->addObserver(this);
@@ -50,23 +123,19 @@ IEntity *SimulationModel::createEntity(const JsonObject &entity) {
 		} else if (type == "drone") {
 			// MODIFIED SUBSCRIBER
 			// Allows for drones to subscribe to POIs while also
-			// maintaing list of pointers to each drone
-			IObserver *o = dynamic_cast<IObserver *>(myNewEntity);
-			for (POI *p : pois) {
-				if (p && o) {
-					p->addEntityObserverCombo(dynamic_cast<MultiDeliveryDecorator *>(myNewEntity), o);
+			// maintaing list of pointers to each drone. Drones
+			// composed without multiple deliveries are left out.
+			MultiDeliveryDrone *d = dynamic_cast<MultiDeliveryDrone *>(myNewEntity);
+			if (d) {
+				for (POI *p : pois) {
+					if (p) p->addEntityObserverCombo(d, d);
 				}
+				drones.push_back(d);
 			}
-			drones.push_back(dynamic_cast<MultiDeliveryDecorator *>(myNewEntity));
-
-			// Allow drone to send notifications even with decorator
-			myNewEntity = new DroneBatteryDecorator(dynamic_cast<Drone *>(myNewEntity), 100, 100, 20, 4.0);
-			entities[myNewEntity->getId()] = myNewEntity;
 		} else if (type == "POI") {
 			pois.push_back(dynamic_cast<POI *>(myNewEntity));
-			for (MultiDeliveryDecorator *d : drones) {
-				IObserver *o = dynamic_cast<IObserver *>(d);
-				dynamic_cast<POI *>(myNewEntity)->addEntityObserverCombo(dynamic_cast<MultiDeliveryDecorator *>(d), o);
+			for (MultiDeliveryDrone *d : drones) {
+				dynamic_cast<POI *>(myNewEntity)->addEntityObserverCombo(d, d);
 			}
 		}
 	}
@@ -121,20 +190,78 @@ void SimulationModel::scheduleTrip(const JsonObject &details) {
 }
 
 const routing::Graph *SimulationModel::getGraph() const {
-	return graph;
+	return graph.get();
 }
 
-void SimulationModel::setGraph(const routing::Graph *graph) {
-	if (this->graph) delete this->graph;
-	this->graph = graph;
+PathPlanner *SimulationModel::getPathPlanner() {
+	return &planner;
+}
+
+MotionStore *SimulationModel::getMotionStore() {
+	return &motion;
+}
+
+JobSystem *SimulationModel::getJobSystem() {
+	return &jobs;
+}
+
+void SimulationModel::setDeterministic(bool deterministic) {
+	this->deterministic = deterministic;
+}
+
+bool SimulationModel::isDeterministic() const {
+	return deterministic;
+}
+
+void SimulationModel::setGraph(std::shared_ptr<const routing::Graph> graph) {
+	planner.drain();
+	this->graph = std::move(graph);
 }
 
 /// Updates the simulation
 void SimulationModel::update(double dt) {
+	// Strategies entities make while updating come from the arena too
+	Pooled::Scope pooled(&arena);
+	if (orderChanged) {
+		parallelOrder.clear();
+		serialOrder.clear();
+		for (auto &[id, entity] : entities) {
+			(entity->isSelfContained() ? parallelOrder : serialOrder).push_back(entity);
+		}
+		orderChanged = false;
+	}
+
+	// Compute: self-contained entities update in parallel. Chunks do not
+	// depend on the thread count and keep their own notifications, so the
+	// outcome is the same however the chunks are spread.
+	std::vector<std::vector<std::string>> notes((parallelOrder.size() + chunkSize - 1) / chunkSize);
+	jobs.parallelFor(parallelOrder.size(), chunkSize, [&](size_t begin, size_t end) {
+		// Helpers run chunks for every model, so each chunk sets its own
+		// notes and pool
+		Pooled::Scope chunkPooled(&arena);
+		deferredNotes = &notes[begin / chunkSize];
+		for (size_t i = begin; i < end; i++) parallelOrder[i]->update(dt);
+		deferredNotes = nullptr;
+	});
+
+	// Commit: everything touching shared state runs here in a fixed order
+	for (auto &chunk : notes) {
+		for (auto &message : chunk) notify(message);
+	}
+	for (IEntity *entity : serialOrder) entity->update(dt);
+
+	// Moves every entity its strategy drove this tick, then whatever they
+	// carry, so the view gets this tick's positions
+	jobs.parallelFor(motion.size(), chunkSize, [&](size_t begin, size_t end) { motion.integrate(dt, begin, end); });
+	motion.settle();
 	for (auto &[id, entity] : entities) {
-		entity->update(dt);
 		controller.updateEntity(*entity);
 	}
+
+	// Routes are searched in the background unless the run has to be
+	// repeatable, or there is no helper thread that would ever search them
+	if (deterministic || jobs.getThreadCount() == 1) planner.drain();
+
 	for (int id : removed) {
 		removeFromSim(id);
 	}
@@ -155,11 +282,17 @@ void SimulationModel::removeFromSim(int id) {
 		}
 		controller.removeEntity(*entity);
 		entities.erase(id);
+		orderChanged = true;
 		delete entity;
 	}
 }
 
 void SimulationModel::notify(const std::string &message) const {
+	if (deferredNotes) {
+		// Sent in entity order once the parallel updates are done
+		deferredNotes->push_back(message);
+		return;
+	}
 	JsonObject details;
 	details["message"] = message;
 	this->controller.sendEventToView("Notification", details);
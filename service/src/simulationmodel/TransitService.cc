@@ -1,107 +1,293 @@
+#include <algorithm>
+#include <atomic>
 #include <chrono>  // NOLINT [build/c++11]
+#include <cstdlib>
+#include <filesystem>
 #include <map>
+#include <optional>
+#include <thread>  // NOLINT [build/c++11]
+#include <unordered_map>
+#include <vector>
 
-#include "MultiDeliveryDecorator.h"
-#include "OBJParser.h"
+#include "BinaryWriter.h"
+#include "GraphRegistry.h"
+#include "JobSystem.h"
+#include "MultiDelivery.h"
+#include "SimulationClock.h"
 #include "SimulationModel.h"
+#include "SpscQueue.h"
 #include "WebServer.h"
 
 //--------------------  Controller ----------------------------
-bool stopped = false;
+std::atomic<bool> stopped = false;
+
+/// Clock and model settings shared by every session
+struct SessionSettings {
+	double tickRate = 100;
+	int maxCatchUpSteps = 25;
+	// Job system every session's model runs its jobs on, so sessions share
+	// the cores instead of each starting helpers of its own
+	JobSystem *jobs = nullptr;
+	// Directory files named by clients are resolved under
+	std::string webDir;
+};
+
+/// First byte of every binary frame sent to the view. All values are little
+/// endian. An entity record is its id (int32), position and direction (3 x
+/// float32 each) and color index (uint16, 0 when it has none).
+enum BinaryEvent : uint8_t {
+	BinaryAddEntity = 1,     // entity record, details JSON (uint32 length + UTF-8)
+	BinaryUpdateBatch = 2,   // time (float64), count (uint32), entity records
+	BinaryRemoveEntity = 3,  // id (int32)
+	BinaryColor = 4,         // color index (uint16), name (uint32 length + UTF-8)
+	BinaryAddEntities = 5,   // count (uint32), then each entity as in BinaryAddEntity
+};
+
 /// A Transit Service that communicates with a web page through web sockets.  It
-/// also acts as the controller in the model view controller pattern.
+/// also acts as the controller in the model view controller pattern. Each
+/// session simulates on its own thread and talks to the server thread through
+/// a pair of single producer, single consumer queues.
 class TransitService : public JsonSession, public IController {
    public:
-	TransitService() : model(*this), start(std::chrono::system_clock::now()), time(0.0) {
+	TransitService(const SessionSettings &settings)
+	    : webDir(settings.webDir),
+	      model(*this, *settings.jobs),
+	      clock(settings.tickRate, settings.maxCatchUpSteps),
+	      serverThread(std::this_thread::get_id()) {
+		worker = std::thread(&TransitService::run, this);
+	}
+
+	~TransitService() {
+		running = false;
+		worker.join();
+	}
+
+	/// Called on the server thread as the connection closes, the server
+	/// deletes the session once the simulation thread has stopped rather than
+	/// waiting for its current step
+	void close() {
+		running = false;
+	}
+
+	bool isFinished() const {
+		return finished;
+	}
+
+	/// Called on the server thread, hands the message to the simulation thread
+	void receiveMessage(const std::string &msg) {
+		inbox.push(msg);
+	}
+
+	/// Queues messages from the simulation thread for the server thread to
+	/// send, messages from the server thread itself go out directly
+	void sendMessage(const std::string &msg) {
+		if (std::this_thread::get_id() == serverThread) {
+			JsonSession::sendMessage(msg);
+		} else {
+			outboxBytes += msg.size();
+			outbox.push({msg, false});
+		}
+	}
+
+	/// Binary counterpart of sendMessage
+	void sendBinary(const std::string &data) {
+		if (std::this_thread::get_id() == serverThread) {
+			JsonSession::sendBinary(data);
+		} else {
+			outboxBytes += data.size();
+			outbox.push({data, true});
+		}
+	}
+
+	/// Called on the server thread, sends what the simulation thread produced
+	void update() {
+		WebServerBase::Message msg;
+		while (outbox.pop(msg)) {
+			outboxBytes -= msg.data.size();
+			if (msg.binary) {
+				JsonSession::sendBinary(msg.data);
+			} else {
+				JsonSession::sendMessage(msg.data);
+			}
+		}
 	}
 
 	/// Handles specific commands from the web server
 	void receiveCommand(const std::string &cmd, const JsonObject &data, JsonObject &returnValue) {
 		// std::cout << cmd << ": " << data << std::endl;
-		if (cmd == "CreateEntity") {
-			model.createEntity(data);
+		auto handler = commands.find(cmd);
+		if (handler != commands.end()) (this->*handler->second)(data, returnValue);
+	}
 
-		} else if (cmd == "SetGraph") {
-			std::string path = data["filePath"];
-			model.setGraph(routing::OBJGraphParser(path));
+	void createEntity(const JsonObject &data, JsonObject &returnValue) {
+		model.createEntity(data);
+	}
 
-		} else if (cmd == "ScheduleTrip") {
-			model.scheduleTrip(data);
+	/// Creates every entity in data["entities"], the view gets them in one AddEntities
+	void createEntities(const JsonObject &data, JsonObject &returnValue) {
+		if (data.contains("entities")) model.createEntities(data["entities"]);
+	}
 
-		} else if (cmd == "ping") {
-			if (data.contains("message")) std::cout << std::string(data["message"]) << std::endl;
-			returnValue["response"] = data;
+	/// Loads a scene file on the server, data["filePath"] is relative to the web directory
+	void loadScene(const JsonObject &data, JsonObject &returnValue) {
+		auto path = resolveClientPath(data["filePath"]);
+		if (!path) {
+			returnValue["error"] = "filePath must be a relative path inside the web directory";
+			return;
+		}
+		returnValue["loaded"] = model.loadScene(*path, webDir);
+	}
 
-		} else if (cmd == "Additional") {
-			// Handles user prompt for additional delivery
-			// Reroutes specific drone
+	/// Sets the route graph, data["filePath"] is an OBJ relative to the web directory
+	void setGraph(const JsonObject &data, JsonObject &returnValue) {
+		auto path = resolveClientPath(data["filePath"]);
+		if (!path) {
+			returnValue["error"] = "filePath must be a relative path inside the web directory";
+			return;
+		}
+		model.setGraph(routing::GraphRegistry::acquire(*path));
+	}
 
-			std::string droneName = "";
-			std::string poiName = "";
+	void scheduleTrip(const JsonObject &data, JsonObject &returnValue) {
+		model.scheduleTrip(data);
+	}
 
-			if (data.contains("name")) {
-				droneName = std::string(data["name"]);
-			}
+	void ping(const JsonObject &data, JsonObject &returnValue) {
+		if (data.contains("message")) std::cout << std::string(data["message"]) << std::endl;
+		returnValue["response"] = data;
+	}
 
-			if (data.contains("POI")) {
-				poiName = std::string(data["POI"]);
-			}
+	/// Handles user prompt for additional delivery, reroutes specific drone
+	void additional(const JsonObject &data, JsonObject &returnValue) {
+		std::string droneName = "";
+		std::string poiName = "";
+
+		if (data.contains("name")) {
+			droneName = std::string(data["name"]);
+		}
 
-			MultiDeliveryDecorator *drone_ptr = nullptr;
-			POI *poi_ptr = nullptr;
+		if (data.contains("POI")) {
+			poiName = std::string(data["POI"]);
+		}
 
-			for (MultiDeliveryDecorator *d : model.drones) {
-				// Locates correct drone in simulation
-				std::string checkName = d->getDetails()["name"];
-				if (checkName == droneName) {
-					drone_ptr = d;
-					break;
-				}
-			}
+		MultiDeliveryDrone *drone_ptr = nullptr;
+		POI *poi_ptr = nullptr;
 
-			for (POI *p : model.pois) {
-				// Locates correct POI in simulation
-				std::string checkName = p->getDetails()["name"];
-				if (checkName == poiName) {
-					poi_ptr = p;
-					break;
-				}
+		for (MultiDeliveryDrone *d : model.drones) {
+			// Locates correct drone in simulation
+			std::string checkName = d->getDetails()["name"];
+			if (checkName == droneName) {
+				drone_ptr = d;
+				break;
 			}
-			if (drone_ptr->getPosition().dist(poi_ptr->getPosition()) < 400) {
-				// Calls simulation to order pitstop to POI
-				poi_ptr->pitStopHere(drone_ptr);
+		}
+
+		for (POI *p : model.pois) {
+			// Locates correct POI in simulation
+			std::string checkName = p->getDetails()["name"];
+			if (checkName == poiName) {
+				poi_ptr = p;
+				break;
 			}
+		}
+		if (drone_ptr->getPosition().dist(poi_ptr->getPosition()) < 400) {
+			// Calls simulation to order pitstop to POI
+			poi_ptr->pitStopHere(drone_ptr);
+		}
+	}
 
-		} else if (cmd == "Update") {
-			updateEntites.clear();
+	/// The server clock drives the simulation, clients only set its speed
+	void setSpeed(const JsonObject &data, JsonObject &returnValue) {
+		if (data.contains("simSpeed")) clock.setSpeed(data["simSpeed"]);
+	}
 
-			std::chrono::time_point<std::chrono::system_clock> end = std::chrono::system_clock::now();
-			std::chrono::duration<double> diff = end - start;
-			double delta = diff.count() - time;
-			time += delta;
+	/// Clients that can decode binary frames opt in, everyone else keeps JSON
+	void setProtocol(const JsonObject &data, JsonObject &returnValue) {
+		if (data.contains("binary")) binary = data["binary"];
+	}
 
-			double simSpeed = data["simSpeed"];
-			delta *= simSpeed;
+	void stopSimulation(const JsonObject &data, JsonObject &returnValue) {
+		std::cout << "Stop command administered\n";
+		stopped = true;
+		model.stop();
+	}
 
-			if (delta > 0.1) {
-				for (float f = 0.0; f < delta; f += 0.01) {
-					model.update(0.01);
-				}
-			} else {
-				model.update(delta);
-			}
+	/// Whether the view has fallen behind on what was already sent
+	bool isBacklogged() const {
+		return outboxBytes + getQueuedBytes() > getBacklogLimit();
+	}
 
-			for (auto &[id, entity] : updateEntites) {
-				sendEntity("UpdateEntity", *entity);
-			}
-		} else if (cmd == "stopSimulation") {
-			std::cout << "Stop command administered\n";
-			stopped = true;
-			model.stop();
+	/// Runs the simulation steps that are due and sends the entities that
+	/// visibly changed in one UpdateBatch
+	void step() {
+		int steps = clock.advance();
+		if (steps == 0) return;
+
+		for (int i = 0; i < steps; i++) {
+			model.update(clock.getStep());
+		}
+		// A slow view skips batches, the entities stay in updateEntites so the
+		// next batch carries their latest state. Events other than updates are
+		// never held back, so they still arrive in order.
+		if (isBacklogged()) return;
+
+		std::vector<const IEntity *> changed;
+		for (auto &[id, entity] : updateEntites) {
+			if (markSent(*entity)) changed.push_back(entity);
+		}
+		updateEntites.clear();
+		if (changed.empty()) return;
+
+		if (binary) {
+			BinaryWriter out;
+			out.put<uint8_t>(BinaryUpdateBatch);
+			out.put(clock.getTime());
+			out.put<uint32_t>(changed.size());
+			for (const IEntity *entity : changed) writeEntity(out, *entity);
+			sendBinary(out.take());
+			return;
 		}
+
+		JsonArray entities;
+		for (const IEntity *entity : changed) entities.push(entityState(*entity, false));
+		JsonObject batch;
+		// Simulated time of these states, for interpolating between batches
+		batch["time"] = clock.getTime();
+		batch["entities"] = entities;
+		sendEventToView("UpdateBatch", batch);
 	}
 
 	void sendEntity(const std::string &event, const IEntity &entity, bool includeDetails = true) {
+		markSent(entity);
+		sendEventToView(event, entityState(entity, includeDetails));
+	}
+
+	/// Appends the binary entity record, defining its color first if it is new
+	void writeEntity(BinaryWriter &out, const IEntity &entity) {
+		Vector3 pos = entity.getPosition();
+		Vector3 dir = entity.getDirection();
+		out.put<int32_t>(entity.getId());
+		for (double v : {pos.x, pos.y, pos.z, dir.x, dir.y, dir.z}) out.put<float>(v);
+		out.put<uint16_t>(colorIndex(entity.getColor()));
+	}
+
+	/// Index of a color in this session's palette, sending the view any color
+	/// it has not seen yet
+	uint16_t colorIndex(const std::string &color) {
+		if (color.empty()) return 0;
+		auto [it, added] = colors.try_emplace(color, colors.size() + 1);
+		if (added) {
+			BinaryWriter out;
+			out.put<uint8_t>(BinaryColor);
+			out.put<uint16_t>(it->second);
+			out.putString(color);
+			sendBinary(out.take());
+		}
+		return it->second;
+	}
+
+	/// Position, direction and color of an entity as sent to the view
+	JsonObject entityState(const IEntity &entity, bool includeDetails) {
 		// JsonObject details = entity.GetDetails();
 		JsonObject details;
 		if (includeDetails) {
@@ -116,11 +302,62 @@ class TransitService : public JsonSession, public IController {
 		details["dir"] = dir;
 		std::string col_ = entity.getColor();
 		if (col_ != "") details["color"] = col_;
-		sendEventToView(event, details);
+		return details;
+	}
+
+	/// Records the entity's state as sent to the view
+	/// @return Whether it moved, turned or changed color since last sent
+	bool markSent(const IEntity &entity) {
+		const double posEpsilon = 1e-2;
+		const double dirEpsilon = 1e-3;
+		Vector3 pos = entity.getPosition();
+		Vector3 dir = entity.getDirection();
+		std::string color = entity.getColor();
+		auto [it, added] = sent.try_emplace(entity.getId(), SentState{pos, dir, color});
+		SentState &last = it->second;
+		if (!added && pos.dist(last.pos) <= posEpsilon && dir.dist(last.dir) <= dirEpsilon && color == last.color) {
+			return false;
+		}
+		last = {pos, dir, color};
+		return true;
 	}
 
 	void addEntity(const IEntity &entity) {
-		sendEntity("AddEntity", entity, true);
+		if (!binary) {
+			sendEntity("AddEntity", entity, true);
+			return;
+		}
+		markSent(entity);
+		BinaryWriter out;
+		out.put<uint8_t>(BinaryAddEntity);
+		writeEntity(out, entity);
+		out.putString(entity.getDetails().toString());
+		sendBinary(out.take());
+	}
+
+	/// Sends a batch of new entities as one AddEntities event
+	void addEntities(const std::vector<const IEntity *> &entities) {
+		if (binary) {
+			BinaryWriter out;
+			out.put<uint8_t>(BinaryAddEntities);
+			out.put<uint32_t>(entities.size());
+			for (const IEntity *entity : entities) {
+				markSent(*entity);
+				writeEntity(out, *entity);
+				out.putString(entity->getDetails().toString());
+			}
+			sendBinary(out.take());
+			return;
+		}
+
+		JsonArray added;
+		for (const IEntity *entity : entities) {
+			markSent(*entity);
+			added.push(entityState(*entity, true));
+		}
+		JsonObject details;
+		details["entities"] = added;
+		sendEventToView("AddEntities", details);
 	}
 
 	void updateEntity(const IEntity &entity) {
@@ -128,9 +365,17 @@ class TransitService : public JsonSession, public IController {
 	}
 
 	void removeEntity(const IEntity &entity) {
+		updateEntites.erase(entity.getId());
+		sent.erase(entity.getId());
+		if (binary) {
+			BinaryWriter out;
+			out.put<uint8_t>(BinaryRemoveEntity);
+			out.put<int32_t>(entity.getId());
+			sendBinary(out.take());
+			return;
+		}
 		JsonObject details;
 		details["id"] = entity.getId();
-		updateEntites.erase(entity.getId());
 		sendEventToView("RemoveEntity", details);
 	}
 
@@ -143,14 +388,87 @@ class TransitService : public JsonSession, public IController {
 	}
 
    private:
+	/// Simulation thread: handles commands and steps the model on the clock
+	void run() {
+		while (running) {
+			std::string msg;
+			while (inbox.pop(msg)) {
+				JsonSession::receiveMessage(msg);
+			}
+			step();
+			// Sleep until the next step is due, but keep commands responsive when slowed down
+			std::this_thread::sleep_for(std::min<SimulationClock::Clock::duration>(clock.untilNextStep(),
+			                                                                       std::chrono::milliseconds(10)));
+		}
+		finished = true;
+	}
+
+	/// Resolves a file named by a client under the web directory. Absolute
+	/// paths, paths climbing out with .. and symlinks leading outside it are
+	/// refused, so clients cannot make the server read or write anything else.
+	std::optional<std::string> resolveClientPath(const std::string &path) const {
+		auto relative = std::filesystem::path(path).lexically_normal();
+		if (path.empty() || relative.has_root_path()) return std::nullopt;
+		for (const auto &part : relative) {
+			if (part == "..") return std::nullopt;
+		}
+		auto ec = std::error_code();
+		auto root = std::filesystem::weakly_canonical(webDir, ec);
+		if (ec) return std::nullopt;
+		auto resolved = std::filesystem::weakly_canonical(root / relative, ec);
+		if (ec) return std::nullopt;
+		auto [r, f] = std::mismatch(root.begin(), root.end(), resolved.begin(), resolved.end());
+		if (r != root.end()) return std::nullopt;
+		return resolved.string();
+	}
+
+	using CommandHandler = void (TransitService::*)(const JsonObject &, JsonObject &);
+	// Handler for each command the view sends, looked up by name
+	static const std::unordered_map<std::string, CommandHandler> commands;
+
+	// Directory client file paths are resolved under
+	std::string webDir;
 	// Simulation Model
 	SimulationModel model;
-	// Used for tracking time since last update
-	std::chrono::time_point<std::chrono::system_clock> start;
-	// The total time the server has been running.
-	double time;
+	// Fixed time step scheduler driving the model
+	SimulationClock clock;
+	// Messages from the server thread to the simulation thread
+	SpscQueue<std::string> inbox;
+	// Messages from the simulation thread to the server thread
+	SpscQueue<WebServerBase::Message> outbox;
+	// Bytes in the outbox, counted towards the session's backlog
+	std::atomic<size_t> outboxBytes = 0;
+	std::thread::id serverThread;
+	std::atomic<bool> running = true;
+	// Set by the simulation thread as it exits
+	std::atomic<bool> finished = false;
+	std::thread worker;
 	// Current entities to update
 	std::map<int, const IEntity *> updateEntites;
+	// Last state sent to the view for each entity
+	struct SentState {
+		Vector3 pos;
+		Vector3 dir;
+		std::string color;
+	};
+	std::map<int, SentState> sent;
+	// Whether the view asked for binary entity frames
+	bool binary = false;
+	// Palette of colors already sent to the view, indices start at 1
+	std::map<std::string, uint16_t> colors;
+};
+
+const std::unordered_map<std::string, TransitService::CommandHandler> TransitService::commands = {
+    {"CreateEntity", &TransitService::createEntity},
+    {"CreateEntities", &TransitService::createEntities},
+    {"LoadScene", &TransitService::loadScene},
+    {"SetGraph", &TransitService::setGraph},
+    {"ScheduleTrip", &TransitService::scheduleTrip},
+    {"ping", &TransitService::ping},
+    {"Additional", &TransitService::additional},
+    {"Update", &TransitService::setSpeed},
+    {"SetProtocol", &TransitService::setProtocol},
+    {"stopSimulation", &TransitService::stopSimulation},
 };
 
 /// The main program that handles starting the web sockets service.
@@ -158,12 +476,27 @@ int main(int argc, char **argv) {
 	if (argc > 1) {
 		int port = std::atoi(argv[1]);
 		std::string webDir = std::string(argv[2]);
-		WebServer<TransitService> server(port, webDir);
+		SessionSettings settings;
+		settings.webDir = webDir;
+		if (argc > 3) settings.tickRate = std::atof(argv[3]);
+		if (argc > 4) settings.maxCatchUpSteps = std::atoi(argv[4]);
+		// At least one helper by default, so routes are searched while sessions tick
+		int threads = argc > 6 ? std::max(1, std::atoi(argv[6]))
+		                       : std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+		// Outlives the server and with it every session
+		JobSystem jobs(threads);
+		settings.jobs = &jobs;
+		WebServerWithState<TransitService, SessionSettings> server(settings, port, webDir);
+		if (argc > 5) server.frameBudget = std::atoi(argv[5]);
+		// Wake up at least once per tick even when no messages arrive
+		int wait = std::max(1, static_cast<int>(1000 / std::max(settings.tickRate, 1.0)));
 		while (!stopped) {
-			server.service();
+			server.service(wait);
 		}
 	} else {
-		std::cout << "Usage: ./build/bin/transit_service <port> apps/transit_service/web/" << std::endl;
+		std::cout << "Usage: ./build/bin/transit_service <port> apps/transit_service/web/ [tickRate] [maxCatchUpSteps] "
+		             "[frameBudget] [threads]"
+		          << std::endl;
 	}
 
 	return 0;
@@ -7,10 +7,19 @@ Copyright (c) 2019 Dan Orban
 #include <algorithm>
 #include <iostream>
 
+#include "OutboundQueue.h"
+
 struct WebServerSessionState {
 	struct lws *wsi;
 	std::vector<std::string> inMessages;
-	std::vector<std::string> outMessages;
+	// Fragments of the message being received, until its last one arrives
+	std::string partial;
+	OutboundQueue outMessages;
+	// Scratch space for coalesced frames, with LWS_PRE bytes of headroom
+	std::vector<unsigned char> frame;
+	size_t frameBudget;
+	size_t maxBacklog;
+	bool closing = false;
 	std::vector<WebServerBase::Session *> *sessions;
 	std::map<int, WebServerBase::Session *> *sessionMap;
 };
@@ -30,35 +39,92 @@ WebServerBase::Session::~Session() {
 	}
 
 	std::map<int, Session *> &sessionMap = *sessionState->sessionMap;
-	sessionMap.erase(sessionMap.find(id));
+	sessionMap.erase(id);
 
 	delete sessionState;
 }
 
 void WebServerBase::Session::sendMessage(const std::string &msg) {
+	queueMessage(msg, false);
+}
+
+void WebServerBase::Session::sendBinary(const std::string &data) {
+	queueMessage(data, true);
+}
+
+void WebServerBase::Session::queueMessage(const std::string &data, bool binary) {
 	WebServerSessionState &sessionState = *static_cast<WebServerSessionState *>(state);
-	sessionState.outMessages.push_back(msg);
+	if (sessionState.closing) return;
+	if (queuedBytes + data.size() > sessionState.maxBacklog) {
+		std::cout << "Closing session " << id << ", " << queuedBytes << " bytes are waiting to be sent" << std::endl;
+		sessionState.closing = true;
+		lws_set_timeout(sessionState.wsi, PENDING_TIMEOUT_USER_OK, LWS_TO_KILL_ASYNC);
+		return;
+	}
+	sessionState.outMessages.push(data, binary);
+	queuedBytes += data.size();
 	lws_callback_on_writable(sessionState.wsi);
 }
 
-void WebServerBase::Session::onWrite() {
+bool WebServerBase::Session::onWrite() {
 	WebServerSessionState &sessionState = *static_cast<WebServerSessionState *>(state);
 
-	if (sessionState.outMessages.size() == 0) {
-		return;
-	}
-	std::string val = sessionState.outMessages[0];
+	// Keep writing while the socket takes more, the server clock now produces
+	// updates faster than one message per writable callback, and pack runs of
+	// small messages into frames of up to frameBudget bytes
+	OutboundQueue &queue = sessionState.outMessages;
+	bool first = true;
+	while (!queue.empty() && (first || !lws_send_pipe_choked(sessionState.wsi))) {
+		OutboundQueue::Buffer &msg = queue.front();
+		bool binary = msg.isBinary();
+		// Text messages are JSON and coalesce into a JSON array, binary ones
+		// into a frame of type 0 holding length prefixed messages
+		size_t count = 1;
+		size_t size = binary ? 1 + 4 + msg.size() : 1 + msg.size() + 1;
+		while (count < queue.size() && queue[count].isBinary() == binary) {
+			size_t next = size + (binary ? 4 : 1) + queue[count].size();
+			if (next > sessionState.frameBudget) break;
+			size = next;
+			count++;
+		}
 
-	int newLen = val.length();
-	unsigned char *buf = (unsigned char *)malloc(LWS_SEND_BUFFER_PRE_PADDING + newLen + LWS_SEND_BUFFER_POST_PADDING);
-	memcpy(&buf[LWS_SEND_BUFFER_PRE_PADDING], val.c_str(), newLen);
-	lws_write(sessionState.wsi, &buf[LWS_SEND_BUFFER_PRE_PADDING], newLen, LWS_WRITE_TEXT);
-	free(buf);
-	sessionState.outMessages.erase(sessionState.outMessages.begin());
+		int written;
+		if (count == 1) {
+			// Sent in place, the buffer already has the headroom lws_write needs
+			written = lws_write(sessionState.wsi, msg.payload(), msg.size(),
+			                    binary ? LWS_WRITE_BINARY : LWS_WRITE_TEXT);
+		} else {
+			std::vector<unsigned char> &frame = sessionState.frame;
+			if (frame.size() < LWS_PRE + size) frame.resize(LWS_PRE + size);
+			unsigned char *out = frame.data() + LWS_PRE;
+			*out++ = binary ? 0 : '[';
+			for (size_t i = 0; i < count; i++) {
+				OutboundQueue::Buffer &part = queue[i];
+				if (binary) {
+					uint32_t length = part.size();
+					for (int b = 0; b < 4; b++) *out++ = length >> (8 * b);
+				} else if (i > 0) {
+					*out++ = ',';
+				}
+				memcpy(out, part.payload(), part.size());
+				out += part.size();
+			}
+			if (!binary) *out++ = ']';
+			written = lws_write(sessionState.wsi, frame.data() + LWS_PRE, size,
+			                    binary ? LWS_WRITE_BINARY : LWS_WRITE_TEXT);
+		}
+		// The connection is broken, dropping the messages would leave the
+		// view silently out of date
+		if (written < 0) return false;
+		for (size_t i = 0; i < count; i++) queuedBytes -= queue[i].size();
+		queue.pop(count);
+		first = false;
+	}
 
-	if (sessionState.outMessages.size() > 0) {
+	if (!queue.empty()) {
 		lws_callback_on_writable(sessionState.wsi);
 	}
+	return true;
 }
 
 struct web_server_per_session_data_input {
@@ -126,17 +192,30 @@ int callback_web_server(struct lws *wsi, enum lws_callback_reasons reason, void
 			break;
 		}
 		case LWS_CALLBACK_CLOSED: {
-			delete pss->impl;
+			WebServer->closeSession(pss->impl);
 			std::cout << "Connection closed" << std::endl;
 			break;
 		}
 		case LWS_CALLBACK_RECEIVE: {
-			std::string data(reinterpret_cast<char *>(in), len);
-			pss->state->inMessages.push_back(data);
+			// Large messages arrive in several fragments, hand the session
+			// whole messages only
+			std::string &partial = pss->state->partial;
+			size_t remaining = lws_remaining_packet_payload(wsi);
+			if (partial.empty() && remaining == 0 && lws_is_final_fragment(wsi)) {
+				pss->state->inMessages.emplace_back(reinterpret_cast<char *>(in), len);
+				break;
+			}
+			partial.reserve(partial.size() + len + remaining);
+			partial.append(reinterpret_cast<char *>(in), len);
+			if (remaining == 0 && lws_is_final_fragment(wsi)) {
+				pss->state->inMessages.push_back(std::move(partial));
+				partial.clear();
+			}
 			break;
 		}
 		case LWS_CALLBACK_SERVER_WRITEABLE: {
-			pss->impl->onWrite();
+			// Returning -1 has lws close the connection
+			if (!pss->impl->onWrite()) return -1;
 
 			break;
 		}
@@ -237,6 +316,8 @@ struct lws_protocols web_server_protocols[] = {
 WebServerBase::WebServerBase(int port, const std::string &webDir) : webDir(webDir) {
 	struct lws_context_creation_info info;
 
+	memset(&wakeTimer, 0, sizeof(wakeTimer));
+
 	memset(&info, 0, sizeof(info));
 
 	info.port = port;
@@ -267,6 +348,8 @@ WebServerBase::WebServerBase(int port, const std::string &webDir) : webDir(webDi
 }
 
 WebServerBase::~WebServerBase() {
+	for (Session *session : closedSessions) delete session;
+	lws_sul_cancel(&wakeTimer);
 	lws_context_destroy(context);
 }
 
@@ -280,12 +363,30 @@ void WebServerBase::createSession(void *info) {
 	session->state = pss->state;
 	pss->state->sessions = &sessions;
 	pss->state->sessionMap = &sessionMap;
+	pss->state->frameBudget = frameBudget;
+	pss->state->maxBacklog = maxBacklog;
+	session->backlogLimit = backlogLimit;
 	sessionMap[session->getId()] = session;
 	std::string id = std::to_string(session->getId());
 	session->sendMessage(id);
 }
 
+void WebServerBase::closeSession(Session *session) {
+	// Nothing reaches the session from here on, though it may still be busy
+	std::erase(sessions, session);
+	sessionMap.erase(session->getId());
+	static_cast<WebServerSessionState *>(session->state)->closing = true;
+	session->close();
+	closedSessions.push_back(session);
+}
+
+static void wakeUp(lws_sorted_usec_list_t *sul) {
+}
+
 void WebServerBase::service(int time) {
+	// lws ignores the service timeout and sleeps until its next scheduled
+	// event, so schedule one to get control back within time ms
+	lws_sul_schedule(context, 0, &wakeTimer, wakeUp, time * LWS_US_PER_MS);
 	lws_service(context, time);
 	for (int f = 0; f < sessions.size(); f++) {
 		WebServerSessionState *sessionState = static_cast<WebServerSessionState *>(sessions[f]->state);
@@ -297,4 +398,9 @@ void WebServerBase::service(int time) {
 
 		sessionState->inMessages.clear();
 	}
+	std::erase_if(closedSessions, [](Session *session) {
+		if (!session->isFinished()) return false;
+		delete session;
+		return true;
+	});
 }
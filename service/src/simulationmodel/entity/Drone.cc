@@ -4,9 +4,12 @@
 #include <cmath>
 #include <limits>
 
+#include "AltStrategy.h"
 #include "AstarStrategy.h"
 #include "BeelineStrategy.h"
 #include "BfsStrategy.h"
+#include "BidirectionalAstarStrategy.h"
+#include "ChStrategy.h"
 #include "DfsStrategy.h"
 #include "DijkstraStrategy.h"
 #include "JumpDecorator.h"
@@ -38,21 +41,32 @@ void Drone::getNextDelivery() {
 			Vector3 packagePosition = package->getPosition();
 			Vector3 finalDestination = package->getDestination();
 
-			toPackage = new BeelineStrategy(position, packagePosition);
+			toPackage = new BeelineStrategy(getPosition(), packagePosition);
 
 			std::string strat = package->getStrategyName();
+			const routing::Graph *graph = model->getGraph();
+			PathPlanner *planner = model->getPathPlanner();
 			if (strat == "astar") {
 				toFinalDestination =
-				    new JumpDecorator(new AstarStrategy(packagePosition, finalDestination, model->getGraph()));
+				    new JumpDecorator(new AstarStrategy(packagePosition, finalDestination, graph, planner));
 			} else if (strat == "dfs") {
 				toFinalDestination = new SpinDecorator(
-				    new JumpDecorator(new DfsStrategy(packagePosition, finalDestination, model->getGraph())));
+				    new JumpDecorator(new DfsStrategy(packagePosition, finalDestination, graph, planner)));
 			} else if (strat == "bfs") {
 				toFinalDestination = new SpinDecorator(
-				    new SpinDecorator(new BfsStrategy(packagePosition, finalDestination, model->getGraph())));
+				    new SpinDecorator(new BfsStrategy(packagePosition, finalDestination, graph, planner)));
 			} else if (strat == "dijkstra") {
 				toFinalDestination = new JumpDecorator(
-				    new SpinDecorator(new DijkstraStrategy(packagePosition, finalDestination, model->getGraph())));
+				    new SpinDecorator(new DijkstraStrategy(packagePosition, finalDestination, graph, planner)));
+			} else if (strat == "bidastar") {
+				toFinalDestination = new JumpDecorator(new JumpDecorator(
+				    new BidirectionalAstarStrategy(packagePosition, finalDestination, graph, planner)));
+			} else if (strat == "alt") {
+				toFinalDestination =
+				    new SpinDecorator(new AltStrategy(packagePosition, finalDestination, graph, planner));
+			} else if (strat == "ch") {
+				toFinalDestination = new SpinDecorator(
+				    new JumpDecorator(new ChStrategy(packagePosition, finalDestination, graph, planner)));
 			} else {
 				toFinalDestination = new BeelineStrategy(packagePosition, finalDestination);
 			}
@@ -85,9 +99,10 @@ void Drone::update(double dt) {
 	} else if (toFinalDestination) {
 		toFinalDestination->move(this, dt);
 
-		if (package && pickedUp) {
-			package->setPosition(position);
-			package->setDirection(direction);
+		// The package rides along once the drone has moved this tick
+		if (package && pickedUp && !package->follow(*this)) {
+			package->setPosition(getPosition());
+			package->setDirection(getDirection());
 		}
 
 		if (toFinalDestination->isCompleted()) {
@@ -1,21 +1,27 @@
-#include "DroneBatteryDecorator.h"
+#include "DroneBattery.h"
 #include <climits>
 #include "BeelineStrategy.h"
 #include "IStrategy.h"
+#include "MultiDelivery.h"
+#include "SimulationModel.h"
 
-DroneBatteryDecorator::DroneBatteryDecorator(Drone *drone, unsigned maxCharge_, unsigned currentCharge_,
-                                             unsigned lowCharge_, double decreaseTime_)
-    : DroneDecorator(drone),
+template <std::derived_from<Drone> Base>
+DroneBattery<Base>::DroneBattery(const JsonObject &obj, unsigned maxCharge_, unsigned currentCharge_,
+                                 unsigned lowCharge_, double decreaseTime_)
+    : Base(obj),
       maxCharge(maxCharge_),
       currentCharge(currentCharge_),
       lowCharge(lowCharge_),
       movingDecreaseTime(decreaseTime_) {
 }
 
-DroneBatteryDecorator::~DroneBatteryDecorator() {
+template <std::derived_from<Drone> Base>
+DroneBattery<Base>::~DroneBattery() {
+	if (toRechargeStation) delete toRechargeStation;
 }
 
-void DroneBatteryDecorator::decreaseCharge(double dt) {
+template <std::derived_from<Drone> Base>
+void DroneBattery<Base>::decreaseCharge(double dt) {
 	if (currentCharge <= 0) {
 		timeElapsed = 0;
 		return;
@@ -29,25 +35,26 @@ void DroneBatteryDecorator::decreaseCharge(double dt) {
 
 		// Create message to show the drone's charge ever 20%
 		if (createMessage) {
-			std::string message = getName() + " now at " + std::to_string(currentCharge) + "% charge";
-			sub->notifyObservers(message);
+			std::string message = this->getName() + " now at " + std::to_string(currentCharge) + "% charge";
+			this->notifyObservers(message);
 		}
 
 		if (currentCharge <= 0) {
-			std::string message = getName() + " has died";
-			sub->notifyObservers(message);
+			std::string message = this->getName() + " has died";
+			this->notifyObservers(message);
 		}
 	}
 }
 
-void DroneBatteryDecorator::charge(double dt) {
+template <std::derived_from<Drone> Base>
+void DroneBattery<Base>::charge(double dt) {
 	if (malfunctionedStationTime > 0) {
 		// Recharge station is malfunctioned, so do not charge
 		// until the station is no longer malfunctioned.
 		malfunctionedStationTime -= dt;
 		if (malfunctionedStationTime <= 0) {
-			std::string message = "Station charging " + getName() + " has been fixed.";
-			sub->notifyObservers(message);
+			std::string message = "Station charging " + this->getName() + " has been fixed.";
+			this->notifyObservers(message);
 			malfunctionedStationTime = 0;
 		}
 	}
@@ -66,18 +73,20 @@ void DroneBatteryDecorator::charge(double dt) {
 			// Drone has reached max charge
 			currentCharge = maxCharge;
 
-			std::string message = getName() + " is now fully charged";
-			sub->notifyObservers(message);
+			std::string message = this->getName() + " is now fully charged";
+			this->notifyObservers(message);
 		}
 	}
 }
 
-Vector3 DroneBatteryDecorator::findNearestRechargeStation() {
-	return findNearestRechargeStation(sub->getPosition());
+template <std::derived_from<Drone> Base>
+Vector3 DroneBattery<Base>::findNearestRechargeStation() {
+	return findNearestRechargeStation(this->getPosition());
 }
 
-Vector3 DroneBatteryDecorator::findNearestRechargeStation(Vector3 start) {
-	std::vector<Vector3> rechargeStations = getModel()->getRechargeStations();
+template <std::derived_from<Drone> Base>
+Vector3 DroneBattery<Base>::findNearestRechargeStation(Vector3 start) {
+	std::vector<Vector3> rechargeStations = this->model->getRechargeStations();
 	double minDist = std::numeric_limits<double>::max();
 	Vector3 nearestStation;
 	for (const auto &station : rechargeStations) {
@@ -87,33 +96,35 @@ Vector3 DroneBatteryDecorator::findNearestRechargeStation(Vector3 start) {
 		}
 	}
 
-	nearestStation.y = sub->getPosition().y;
+	nearestStation.y = this->getPosition().y;
 
 	return nearestStation;
 }
 
-bool DroneBatteryDecorator::isAtRechargeStation() {
-	std::vector<Vector3> rechargeStations = getModel()->getRechargeStations();
+template <std::derived_from<Drone> Base>
+bool DroneBattery<Base>::isAtRechargeStation() {
+	std::vector<Vector3> rechargeStations = this->model->getRechargeStations();
 	for (auto station : rechargeStations) {
-		station.y = sub->getPosition().y;
+		station.y = this->getPosition().y;
 
 		// Check if position is close enough to the station
-		if (sub->getPosition().dist(station) <= 5.0) {
+		if (this->getPosition().dist(station) <= 5.0) {
 			return true;
 		}
 	}
 	return false;
 }
 
-void DroneBatteryDecorator::lookAheadForRechargeStation() {
+template <std::derived_from<Drone> Base>
+void DroneBattery<Base>::lookAheadForRechargeStation() {
 	if (isAtRechargeStation() || toRechargeStation) {
 		return;
 	}
 
 	// Check if drone has enough max battery for
 
-	bool isFinalDestinationValid = sub->getToFinalDestinationStrategy();
-	bool isToPackageValid = sub->getToFinalDestinationStrategy();
+	bool isFinalDestinationValid = this->getToFinalDestinationStrategy() != nullptr;
+	bool isToPackageValid = this->getToPackageStrategy() != nullptr;
 
 	if (!isToPackageValid && !isFinalDestinationValid) {
 		// Drone is idle
@@ -122,16 +133,16 @@ void DroneBatteryDecorator::lookAheadForRechargeStation() {
 
 	double distanceToDestination = 0;
 	double distanceToBattery = 0;
-	Vector3 currentPosition = sub->getPosition();
+	Vector3 currentPosition = this->getPosition();
 
-	if (sub->getToPackageStrategy()) {
-		IStrategy *strategy = sub->getToPackageStrategy();
+	if (this->getToPackageStrategy()) {
+		IStrategy *strategy = this->getToPackageStrategy();
 
 		distanceToBattery = strategy->currentPathDistance(currentPosition);
 		distanceToDestination += distanceToBattery;
 	}
-	if (sub->getToFinalDestinationStrategy()) {
-		IStrategy *strategy = sub->getToFinalDestinationStrategy();
+	if (this->getToFinalDestinationStrategy()) {
+		IStrategy *strategy = this->getToFinalDestinationStrategy();
 
 		distanceToDestination += strategy->currentPathDistance(currentPosition);
 	}
@@ -144,8 +155,8 @@ void DroneBatteryDecorator::lookAheadForRechargeStation() {
 
 		if (currentCharge - distanceToBattery <= lowCharge) {
 			std::string message =
-			    getName() + " does not have enough charge to get to package, " + "so heading to recharge station";
-			sub->notifyObservers(message);
+			    this->getName() + " does not have enough charge to get to package, " + "so heading to recharge station";
+			this->notifyObservers(message);
 			headToRechargeStation(findNearestRechargeStation());
 		}
 		return;
@@ -155,27 +166,30 @@ void DroneBatteryDecorator::lookAheadForRechargeStation() {
 		// Not enough charge to finish current path, so go towards the
 		// nearest recharge station
 		std::string message =
-		    getName() + " does not have enough charge to finish strategy, " + "so heading to recharge station";
-		sub->notifyObservers(message);
+		    this->getName() + " does not have enough charge to finish strategy, " + "so heading to recharge station";
+		this->notifyObservers(message);
 		headToRechargeStation(findNearestRechargeStation());
 	}
 }
 
-double DroneBatteryDecorator::batteryNeededForDistance(double distance) {
-	double speed = sub->getSpeed();
+template <std::derived_from<Drone> Base>
+double DroneBattery<Base>::batteryNeededForDistance(double distance) {
+	double speed = this->getSpeed();
 	double batteryDecreasePerSecond = 2 / (movingDecreaseTime);
 	double timeNeeded = distance / speed;
 	double totalBatteryNeeded = batteryDecreasePerSecond * timeNeeded;
 	return totalBatteryNeeded;
 }
 
-void DroneBatteryDecorator::headToRechargeStation(Vector3 station) {
-	toRechargeStation = new BeelineStrategy(sub->getPosition(), station);
+template <std::derived_from<Drone> Base>
+void DroneBattery<Base>::headToRechargeStation(Vector3 station) {
+	toRechargeStation = new BeelineStrategy(this->getPosition(), station);
 }
 
-void DroneBatteryDecorator::update(double dt) {
+template <std::derived_from<Drone> Base>
+void DroneBattery<Base>::update(double dt) {
 	if (currentCharge <= 0 && !isAtRechargeStation()) {
-		for (auto i = getModel()->chargingDrones.begin(); i != getModel()->chargingDrones.end(); ++i) {
+		for (auto i = this->model->chargingDrones.begin(); i != this->model->chargingDrones.end(); ++i) {
 			if (*i == this) {
 				return;
 			}
@@ -198,14 +212,14 @@ void DroneBatteryDecorator::update(double dt) {
 	}
 
 	if (toRechargeStation) {
-		toRechargeStation->move(sub, dt);
+		toRechargeStation->move(this, dt);
 
 		if (isAtRechargeStation()) {
 			// Drone has reached the recharge station
 			arriveAtRechargeStation();
 		}
 	} else if (droneReady) {
-		sub->update(dt);
+		Base::update(dt);
 	}
 
 	if (isAtRechargeStation() && notCharging == false) {
@@ -227,19 +241,23 @@ void DroneBatteryDecorator::update(double dt) {
 
 	// Check if drone needs to check lookAheadForRechargeStation
 
-	bool isToPackageValid = sub->getToPackageStrategy() != nullptr;
+	bool isToPackageValid = this->getToPackageStrategy() != nullptr;
 	if (goingToPackage && !isToPackageValid) {
 		// Just picked up the package
 		goingToPackage = false;
 	}
 
-	bool isFinalDestinationValid = sub->getToFinalDestinationStrategy() != nullptr;
+	bool isFinalDestinationValid = this->getToFinalDestinationStrategy() != nullptr;
 	if (goingToFinalDestination && !isFinalDestinationValid) {
 		goingToFinalDestination = false;
 	}
 
+	// The look ahead needs the full route, so wait until it has been planned
+	bool isPlanning = (isToPackageValid && this->getToPackageStrategy()->isPending()) ||
+	                  (isFinalDestinationValid && this->getToFinalDestinationStrategy()->isPending());
+
 	if (isToPackageValid) {
-		if (!goingToPackage) {
+		if (!goingToPackage && !isPlanning) {
 			goingToPackage = true;
 			lookAheadForRechargeStation();
 		}
@@ -258,8 +276,8 @@ void DroneBatteryDecorator::update(double dt) {
 	if (droneIsIdle) {
 		if (idleFrames >= 5) {
 			// Drone is idle, so go to recharge station
-			std::string message = getName() + " is idle, so heading to recharge station";
-			sub->notifyObservers(message);
+			std::string message = this->getName() + " is idle, so heading to recharge station";
+			this->notifyObservers(message);
 			headToRechargeStation(findNearestRechargeStation());
 		} else {
 			idleFrames += 1;
@@ -269,28 +287,32 @@ void DroneBatteryDecorator::update(double dt) {
 	}
 }
 
-void DroneBatteryDecorator::addToDeadDronesList() {
-	if (std::find(getModel()->deadDrones.begin(), getModel()->deadDrones.end(), this) == getModel()->deadDrones.end())
-		getModel()->deadDrones.push_back(this);
+template <std::derived_from<Drone> Base>
+void DroneBattery<Base>::addToDeadDronesList() {
+	if (std::find(this->model->deadDrones.begin(), this->model->deadDrones.end(), this) == this->model->deadDrones.end())
+		this->model->deadDrones.push_back(this);
 }
 
-void DroneBatteryDecorator::addToFunctionalDroneList() {
-	if (std::find(getModel()->functionalDrones.begin(), getModel()->functionalDrones.end(), this) ==
-	    getModel()->functionalDrones.end())
-		getModel()->functionalDrones.push_back(this);
+template <std::derived_from<Drone> Base>
+void DroneBattery<Base>::addToFunctionalDroneList() {
+	if (std::find(this->model->functionalDrones.begin(), this->model->functionalDrones.end(), this) ==
+	    this->model->functionalDrones.end())
+		this->model->functionalDrones.push_back(this);
 }
 
-void DroneBatteryDecorator::removeFromFunctionalDroneList() {
-	getModel()->functionalDrones.erase(
-	    std::remove(getModel()->functionalDrones.begin(), getModel()->functionalDrones.end(), this),
-	    getModel()->functionalDrones.end());
+template <std::derived_from<Drone> Base>
+void DroneBattery<Base>::removeFromFunctionalDroneList() {
+	this->model->functionalDrones.erase(
+	    std::remove(this->model->functionalDrones.begin(), this->model->functionalDrones.end(), this),
+	    this->model->functionalDrones.end());
 }
 
-void DroneBatteryDecorator::arriveAtRechargeStation() {
+template <std::derived_from<Drone> Base>
+void DroneBattery<Base>::arriveAtRechargeStation() {
 	delete toRechargeStation;
 	toRechargeStation = nullptr;
-	std::string message = getName() + " arrived at recharge station";
-	sub->notifyObservers(message);
+	std::string message = this->getName() + " arrived at recharge station";
+	this->notifyObservers(message);
 
 	// Check to see if the recharge has malfunctioned (10% chance
 	// to malfunction.) If the station has malfunctioned, wait 10
@@ -303,9 +325,13 @@ void DroneBatteryDecorator::arriveAtRechargeStation() {
 
 		std::string firstHalfMessage = "Station has malfunctioned ";
 		std::string secondHalfMessage =
-		    "attempting to recharge" + getName() + ". Please wait 10 seconds for it to be fixed.";
+		    "attempting to recharge" + this->getName() + ". Please wait 10 seconds for it to be fixed.";
 
 		std::string message = firstHalfMessage + secondHalfMessage;
-		sub->notifyObservers(message);
+		this->notifyObservers(message);
 	}
 }
+
+// The compositions DroneFactory builds
+template class DroneBattery<Drone>;
+template class DroneBattery<MultiDelivery<Drone>>;
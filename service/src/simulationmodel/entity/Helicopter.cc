@@ -6,8 +6,8 @@
 
 #include "BeelineStrategy.h"
 
-Helicopter::Helicopter(const JsonObject &obj) : IEntity(obj) {
-	this->lastPosition = this->position;
+Helicopter::Helicopter(const JsonObject &obj) : IEntity(obj), rng(rand()) {
+	this->lastPosition = getPosition();
 }
 
 Helicopter::~Helicopter() {
@@ -19,10 +19,10 @@ void Helicopter::update(double dt) {
 		movement->move(this, dt);
 
 		// Calculate how far it moved since last frame
-		double diff = this->lastPosition.dist(this->position);
+		double diff = this->lastPosition.dist(getPosition());
 
 		// Update the position for next time
-		this->lastPosition = this->position;
+		this->lastPosition = getPosition();
 
 		// Update distance traveled
 		this->distanceTraveled += diff;
@@ -39,9 +39,9 @@ void Helicopter::update(double dt) {
 	} else {
 		if (movement) delete movement;
 		Vector3 dest;
-		dest.x = ((static_cast<double>(rand())) / RAND_MAX) * (2900) - 1400;
-		dest.y = position.y;
-		dest.z = ((static_cast<double>(rand())) / RAND_MAX) * (1600) - 800;
-		movement = new BeelineStrategy(position, dest);
+		dest.x = std::uniform_real_distribution<double>(-1400, 1500)(rng);
+		dest.y = getPosition().y;
+		dest.z = std::uniform_real_distribution<double>(-800, 800)(rng);
+		movement = new BeelineStrategy(getPosition(), dest);
 	}
 }
@@ -9,7 +9,7 @@
 
 Vector3 Human::kellerPosition(64.0, 254.0, -210.0);
 
-Human::Human(const JsonObject &obj) : IEntity(obj) {
+Human::Human(const JsonObject &obj) : IEntity(obj), rng(rand()) {
 }
 
 Human::~Human() {
@@ -19,7 +19,7 @@ Human::~Human() {
 void Human::update(double dt) {
 	if (movement && !movement->isCompleted()) {
 		movement->move(this, dt);
-		bool nearKeller = this->position.dist(Human::kellerPosition) < 85;
+		bool nearKeller = getPosition().dist(Human::kellerPosition) < 85;
 		if (nearKeller && !this->atKeller) {
 			std::string message = this->getName() + " visited Keller hall";
 			notifyObservers(message);
@@ -28,9 +28,9 @@ void Human::update(double dt) {
 	} else {
 		if (movement) delete movement;
 		Vector3 dest;
-		dest.x = ((static_cast<double>(rand())) / RAND_MAX) * (2900) - 1400;
-		dest.y = position.y;
-		dest.z = ((static_cast<double>(rand())) / RAND_MAX) * (1600) - 800;
-		if (model) movement = new AstarStrategy(position, dest, model->getGraph());
+		dest.x = std::uniform_real_distribution<double>(-1400, 1500)(rng);
+		dest.y = getPosition().y;
+		dest.z = std::uniform_real_distribution<double>(-800, 800)(rng);
+		if (model) movement = new AstarStrategy(getPosition(), dest, model->getGraph(), model->getPathPlanner());
 	}
 }
@@ -1,9 +1,13 @@
 #include "IEntity.h"
 
+#include <atomic>
+
+#include "SimulationModel.h"
+
 IEntity::IEntity() {
-	static int currentId = 0;
-	id = currentId;
-	currentId++;
+	// Sessions create entities on their own threads
+	static std::atomic<int> currentId = 0;
+	id = currentId++;
 }
 
 IEntity::IEntity(const JsonObject &details) : IEntity() {
@@ -22,10 +26,15 @@ IEntity::IEntity(const JsonObject &details) : IEntity() {
 }
 
 IEntity::~IEntity() {
+	if (motion) motion->remove(motionHandle);
 }
 
 void IEntity::linkModel(SimulationModel *model) {
 	this->model = model;
+	if (model && !motion) {
+		motion = model->getMotionStore();
+		motionHandle = motion->add(position, direction, speed);
+	}
 }
 
 int IEntity::getId() const {
@@ -33,11 +42,11 @@ int IEntity::getId() const {
 }
 
 Vector3 IEntity::getPosition() const {
-	return position;
+	return motion ? motion->getPosition(motionHandle) : position;
 }
 
 Vector3 IEntity::getDirection() const {
-	return direction;
+	return motion ? motion->getDirection(motionHandle) : direction;
 }
 
 const JsonObject &IEntity::getDetails() const {
@@ -53,15 +62,43 @@ std::string IEntity::getName() const {
 }
 
 double IEntity::getSpeed() const {
-	return speed;
+	return motion ? motion->getSpeed(motionHandle) : speed;
+}
+
+void IEntity::setSpeed(double speed_) {
+	if (motion) {
+		motion->setSpeed(motionHandle, speed_);
+	} else {
+		speed = speed_;
+	}
 }
 
 void IEntity::setPosition(Vector3 pos_) {
-	position = pos_;
+	if (motion) {
+		motion->setPosition(motionHandle, pos_);
+	} else {
+		position = pos_;
+	}
 }
 
 void IEntity::setDirection(Vector3 dir_) {
-	direction = dir_;
+	if (motion) {
+		motion->setDirection(motionHandle, dir_);
+	} else {
+		direction = dir_;
+	}
+}
+
+bool IEntity::drive(const Vector3 &target) {
+	if (!motion) return false;
+	motion->drive(motionHandle, target);
+	return true;
+}
+
+bool IEntity::follow(const IEntity &carrier) {
+	if (!motion || carrier.motion != motion) return false;
+	motion->follow(motionHandle, carrier.motionHandle);
+	return true;
 }
 
 void IEntity::setColor(std::string col_) {
@@ -73,7 +110,9 @@ SimulationModel *IEntity::getModel() const {
 }
 
 void IEntity::rotate(double angle) {
-	Vector3 dirTmp = direction;
-	direction.x = dirTmp.x * std::cos(angle) - dirTmp.z * std::sin(angle);
-	direction.z = dirTmp.x * std::sin(angle) + dirTmp.z * std::cos(angle);
+	Vector3 dirTmp = getDirection();
+	Vector3 rotated = dirTmp;
+	rotated.x = dirTmp.x * std::cos(angle) - dirTmp.z * std::sin(angle);
+	rotated.z = dirTmp.x * std::sin(angle) + dirTmp.z * std::cos(angle);
+	setDirection(rotated);
 }
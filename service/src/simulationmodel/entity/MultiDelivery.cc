@@ -0,0 +1,93 @@
+#include "MultiDelivery.h"
+
+#include "BeelineStrategy.h"
+#include "SimulationModel.h"
+
+template <std::derived_from<Drone> Base>
+MultiDelivery<Base>::MultiDelivery(const JsonObject &obj) : Base(obj) {
+	Vector3 proshop = Vector3(698.292, 270, -388.623);
+	Vector3 bookstore = Vector3(-146.3, 270, 49.5);
+	Vector3 subway = Vector3(-670, 270, 166);
+	Vector3 canes = Vector3(-97.0176, 270, -720.15);
+	Vector3 pio_dining_hall = Vector3(387.4, 270, 128.9);
+
+	// If any POIs added, hardcode them in here
+	pois = {proshop, bookstore, subway, canes, pio_dining_hall};
+}
+
+template <std::derived_from<Drone> Base>
+void MultiDelivery<Base>::storeAdditional() {
+	for (Vector3 d : pois) {
+		// If drone is within range to pickup package, add it
+		// to packages.
+		if (this->getPosition().dist(d) < 5 && extra_package && packages[packages.size() - 1] != extra_package) {
+			packages.push_back(extra_package);
+			prompted = false;
+		}
+	}
+}
+
+template <std::derived_from<Drone> Base>
+void MultiDelivery<Base>::pickupAdditional(Vector3 d) {
+	if (this->getPosition().dist(d) < 200 && this->getPickedUp()) {
+		// Ensure original delivery is included in packages
+		if (packages.size() == 0) {
+			packages.push_back(this->getPackage());
+		}
+
+		// Create beeline strategy towards new package
+		IStrategy *packageStrat = new BeelineStrategy(this->getPosition(), d);
+
+		if (this->model) {
+			// Create new package object at POI
+			JsonObject details = JsonObject(this->getPackage()->getDetails());
+			double x = d[0];
+			double y = d[1];
+			double z = d[2];
+			JsonArray newPosition = {x, y, z};
+			details["position"] = newPosition;
+			details["name"] = "Additional POI Package";
+			extra_package = dynamic_cast<Package *>(this->model->createEntity(details));
+		}
+
+		// Record that POI was visited
+		last = d;
+
+		// Redirect drone towards new package
+		this->setToPackage(packageStrat);
+	}
+}
+
+template <std::derived_from<Drone> Base>
+void MultiDelivery<Base>::update(double dt) {
+	// Store additional package if possible
+	storeAdditional();
+
+	// Update all stored packages
+	for (int i = 0; i < packages.size(); i++) {
+		if (packages[i]->follow(*this)) continue;
+		packages[i]->setPosition(this->getPosition());
+		packages[i]->setDirection(this->getDirection());
+	}
+
+	// Once the original delivery is completed, leave all
+	// packages with robot.
+	if (!(this->getPackage())) {
+		packages.clear();
+		last = Vector3();
+		prompted = false;
+	}
+
+	// Update drone
+	Base::update(dt);
+}
+
+template <std::derived_from<Drone> Base>
+void MultiDelivery<Base>::notify(const std::string &message) const {
+	JsonObject details;
+	details["message"] = message;
+	this->model->controller.sendEventToView("Notification", details);
+}
+
+// The compositions DroneFactory builds
+template class MultiDelivery<Drone>;
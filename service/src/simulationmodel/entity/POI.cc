@@ -1,25 +1,41 @@
 #include "POI.h"
 
+#include "SimulationModel.h"
+
 POI::POI(const JsonObject &obj) : IEntity(obj) {
 }
 
 // POIs do not move.
 // Update serves as a check for drones in proximity
 void POI::update(double dt) {
+	// Measures every drone's distance in parallel, prompting stays on this
+	// thread and goes through the drones in order
+	Vector3 position = getPosition();
+	nearby.resize(entity_observers.size());
+	auto measure = [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			nearby[i] = entity_observers[i].first->getPosition().dist(position) < 200;
+		}
+	};
+	if (model) {
+		model->getJobSystem()->parallelFor(nearby.size(), 64, measure);
+	} else {
+		measure(0, nearby.size());
+	}
+
 	// Checks through each drone in the simulation.
-	for (const auto &pair : entity_observers) {
+	for (size_t i = 0; i < entity_observers.size(); i++) {
+		const auto &pair = entity_observers[i];
 		Vector3 last = pair.first->last;
-		Vector3 pos = pair.first->getPosition();
 
 		// Allow drone to be reprompted even if it declined earlier delivery
-		if (pos.dist(getPosition()) < 200 && last != getPosition()) {
+		if (nearby[i] && last != position) {
 			pair.first->prompted = false;
 		}
 
 		// If a drone is nearby, and picked up a package
 		// already then prompt user to pickup an extra.
-		if (pair.first->getPickedUp() && last != getPosition() && pos.dist(getPosition()) < 200 &&
-		    !(pair.first->prompted)) {
+		if (pair.first->getPickedUp() && last != position && nearby[i] && !(pair.first->prompted)) {
 			promptUser(pair.first);
 			std::string message = pair.first->getName() + " is near " + getName();
 			notifyObservers(message);
@@ -27,12 +43,12 @@ void POI::update(double dt) {
 	}
 }
 
-void POI::pitStopHere(MultiDeliveryDecorator *d) {
+void POI::pitStopHere(MultiDeliveryDrone *d) {
 	// Redirect drone to nearby POI
 	d->pickupAdditional(getPosition());
 }
 
-void POI::promptUser(MultiDeliveryDecorator *d) {
+void POI::promptUser(MultiDeliveryDrone *d) {
 	IController &contr = model->controller;
 
 	// Signal to not reprompt user endlessly
@@ -1,6 +1,5 @@
 #include "RechargeDrone.h"
 #include "BeelineStrategy.h"
-#include "DroneBatteryDecorator.h"
 #include "SimulationModel.h"
 
 RechargeDrone::RechargeDrone(const JsonObject &obj) : IEntity(obj) {
@@ -33,8 +32,8 @@ void RechargeDrone::getNextDeadDrone() {
 
 		Vector3 deadDronePosition = deadDrone->getPosition();
 
-		toDeadDrone = new BeelineStrategy(position, deadDronePosition);
-		toChargingStation = new BeelineStrategy(deadDronePosition, position);
+		toDeadDrone = new BeelineStrategy(getPosition(), deadDronePosition);
+		toChargingStation = new BeelineStrategy(deadDronePosition, getPosition());
 	}
 }
 
@@ -1,16 +1,19 @@
 #include "DroneFactory.h"
-#include "MultiDeliveryDecorator.h"
+#include "DroneBattery.h"
+#include "MultiDelivery.h"
 
 IEntity *DroneFactory::createEntity(const JsonObject &entity) {
 	std::string type = entity["type"];
 	if (type.compare("drone") == 0) {
 		std::cout << "Drone Created" << std::endl;
-		Drone *d = new Drone(entity);
-
-		// Drone factory now returns decorator, same exact functionality
-		d = new MultiDeliveryDecorator(d);
-
-		return d;
+		// Drones get a battery and multiple deliveries unless the details turn
+		// them off, each choice is its own composed type
+		bool battery = !entity.contains("battery") || static_cast<bool>(entity["battery"]);
+		bool multiDelivery = !entity.contains("multiDelivery") || static_cast<bool>(entity["multiDelivery"]);
+		if (battery && multiDelivery) return new DroneBattery<MultiDelivery<Drone>>(entity);
+		if (battery) return new DroneBattery<Drone>(entity);
+		if (multiDelivery) return new MultiDelivery<Drone>(entity);
+		return new Drone(entity);
 	}
 	return nullptr;
 }
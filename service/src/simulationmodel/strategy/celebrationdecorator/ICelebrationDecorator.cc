@@ -23,6 +23,10 @@ bool ICelebrationDecorator::isCompleted() {
 	return time <= 0;
 }
 
+bool ICelebrationDecorator::isPending() {
+	return strategy && strategy->isPending();
+}
+
 double ICelebrationDecorator::currentPathDistance(Vector3 startPosition) {
 	if (strategy) {
 		return strategy->currentPathDistance(startPosition);
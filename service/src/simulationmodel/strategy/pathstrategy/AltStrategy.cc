@@ -0,0 +1,7 @@
+#include "AltStrategy.h"
+
+#include "ALT.h"
+
+AltStrategy::AltStrategy(Vector3 pos, Vector3 des, const routing::Graph *g, PathPlanner *planner)
+    : PathStrategy(pos, des, g, std::make_shared<routing::ALT>(), planner) {
+}
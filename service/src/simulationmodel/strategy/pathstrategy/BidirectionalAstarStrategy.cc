@@ -0,0 +1,8 @@
+#include "BidirectionalAstarStrategy.h"
+
+#include "BidirectionalAStar.h"
+
+BidirectionalAstarStrategy::BidirectionalAstarStrategy(Vector3 pos, Vector3 des, const routing::Graph *g,
+                                                       PathPlanner *planner)
+    : PathStrategy(pos, des, g, std::make_shared<routing::BidirectionalAStar>(), planner) {
+}
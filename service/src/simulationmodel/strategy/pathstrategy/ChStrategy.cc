@@ -0,0 +1,7 @@
+#include "ChStrategy.h"
+
+#include "ContractionHierarchySearch.h"
+
+ChStrategy::ChStrategy(Vector3 pos, Vector3 des, const routing::Graph *g, PathPlanner *planner)
+    : PathStrategy(pos, des, g, std::make_shared<routing::ContractionHierarchySearch>(), planner) {
+}
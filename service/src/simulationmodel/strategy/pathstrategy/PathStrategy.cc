@@ -3,8 +3,36 @@
 PathStrategy::PathStrategy(std::vector<Vector3> p) : path(p), index(0) {
 }
 
+PathStrategy::PathStrategy(Vector3 pos, Vector3 des, const routing::Graph *g,
+                           std::shared_ptr<const routing::RoutingStrategy> search, PathPlanner *planner)
+    : index(0), destination(des) {
+	if (!g) {
+		path = {pos, des};
+	} else if (planner) {
+		pending = planner->plan(g, pos, des, search);
+	} else {
+		setRoute(g->getPath(pos, des, *search));
+	}
+}
+
+void PathStrategy::setRoute(const PathPlanner::Path &route) {
+	if (!route.has_value() || route->empty()) {
+		path = {destination};
+		return;
+	}
+	path = route.value();
+	auto y = path.back().y;
+	path.push_back(Vector3(destination.x, y, destination.z));
+}
+
 void PathStrategy::move(IEntity *entity, double dt) {
-	if (isCompleted()) return;
+	// The entity holds its position until the path arrives
+	if (isPending() || isCompleted()) return;
+
+	// Entities in a model are moved by its MotionStore after this update,
+	// so a waypoint reached then is passed on the next move
+	if (entity->getPosition().dist(path[index]) < 4 && ++index >= path.size()) return;
+	if (entity->drive(path[index])) return;
 
 	Vector3 vi = path[index];
 	Vector3 dir = (vi - entity->getPosition()).unit();
@@ -16,7 +44,14 @@ void PathStrategy::move(IEntity *entity, double dt) {
 }
 
 bool PathStrategy::isCompleted() {
-	return index >= path.size();
+	return !isPending() && index >= path.size();
+}
+
+bool PathStrategy::isPending() {
+	if (!pending.valid()) return false;
+	if (pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return true;
+	setRoute(pending.get());
+	return false;
 }
 
 double PathStrategy::currentPathDistance(Vector3 startPosition) {
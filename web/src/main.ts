@@ -34,6 +34,8 @@ let droneData = {};
 
 simSpeedSlider[0].oninput = () => {
   simSpeed = (simSpeedSlider.val() as number) / 10.0;
+  // The server steps the simulation on its own clock, Update only sets its speed
+  sendCommand("Update", { simSpeed: simSpeed });
 };
 
 stopSimulationButton.onclick = () => {
@@ -106,36 +108,121 @@ window.onresize = () => {
 
 initScheduler();
 
+// Palette of entity colors sent by the server, index 0 means no color
+const colors: (string | undefined)[] = [undefined];
+
+// Handles a JSON event, or one decoded from a binary frame
+function handleEvent(data: any) {
+  switch (data.event) {
+    case "AddEntity":
+      addEntity(data.details.id, data.details.details);
+      break;
+    case "AddEntities":
+      data.details.entities.forEach((e: any) => addEntity(e.id, e.details));
+      break;
+    case "UpdateEntity":
+      updateEntity(data.details.id, data.details);
+      break;
+    case "UpdateBatch":
+      data.details.entities.forEach((e: any) => updateEntity(e.id, e));
+      break;
+    case "RemoveEntity":
+      removeEntity(data.details.id);
+      break;
+    case "Notification":
+      notify(data.details.message);
+      break;
+    case "DeliveryScheduled":
+      deliveryPopup.show();
+      deliveryPopup.fadeOut(3000);
+      break;
+    case "AdditionalPrompt":
+      // Occurs when mid-delivery Drone is nearby POI
+      additionalDeliveryPopup.show();
+
+      // Stores drone and POI name
+      droneData = data.details;
+
+      break;
+  }
+}
+
+// Decodes a binary entity frame, see BinaryEvent in TransitService.cc for the layout
+function decodeBinary(view: DataView) {
+  const decoder = new TextDecoder();
+  let offset = 0;
+  const u8 = () => view.getUint8(offset++);
+  const u16 = () => ((offset += 2), view.getUint16(offset - 2, true));
+  const u32 = () => ((offset += 4), view.getUint32(offset - 4, true));
+  const i32 = () => ((offset += 4), view.getInt32(offset - 4, true));
+  const f32 = () => ((offset += 4), view.getFloat32(offset - 4, true));
+  const f64 = () => ((offset += 8), view.getFloat64(offset - 8, true));
+  const str = () => {
+    const length = u32();
+    offset += length;
+    return decoder.decode(new Uint8Array(view.buffer, view.byteOffset + offset - length, length));
+  };
+  const entityWithDetails = () => {
+    const e: any = entity();
+    e.details = JSON.parse(str());
+    return e;
+  };
+  const entity = () => ({
+    id: i32(),
+    pos: [f32(), f32(), f32()],
+    dir: [f32(), f32(), f32()],
+    color: colors[u16()],
+  });
+
+  switch (u8()) {
+    case 0:
+      // Several frames coalesced by the server, each prefixed by its length
+      while (offset < view.byteLength) {
+        const length = u32();
+        decodeBinary(new DataView(view.buffer, view.byteOffset + offset, length));
+        offset += length;
+      }
+      break;
+    case 1:
+      handleEvent({ event: "AddEntity", details: entityWithDetails() });
+      break;
+    case 2: {
+      const time = f64();
+      const entities = Array.from({ length: u32() }, entity);
+      handleEvent({ event: "UpdateBatch", details: { time, entities } });
+      break;
+    }
+    case 3:
+      handleEvent({ event: "RemoveEntity", details: { id: i32() } });
+      break;
+    case 4:
+      colors[u16()] = str();
+      break;
+    case 5: {
+      const entities = Array.from({ length: u32() }, entityWithDetails);
+      handleEvent({ event: "AddEntities", details: { entities } });
+      break;
+    }
+  }
+}
+
 connect().then((socket) => {
+  socket.binaryType = "arraybuffer";
   socket.onmessage = (msg) => {
-    let data = JSON.parse(msg.data);
-    switch (data.event) {
-      case "AddEntity":
-        addEntity(data.details.id, data.details.details);
-        break;
-      case "UpdateEntity":
-        updateEntity(data.details.id, data.details);
-        break;
-      case "RemoveEntity":
-        removeEntity(data.details.id);
-        break;
-      case "Notification":
-        notify(data.details.message);
-        break;
-      case "DeliveryScheduled":
-        deliveryPopup.show();
-        deliveryPopup.fadeOut(3000);
-        break;
-      case "AdditionalPrompt":
-        // Occurs when mid-delivery Drone is nearby POI
-        additionalDeliveryPopup.show();
-
-        // Stores drone and POI name
-        droneData = data.details;
-
-        break;
+    if (msg.data instanceof ArrayBuffer) {
+      decodeBinary(new DataView(msg.data));
+    } else {
+      // Queued events arrive coalesced into an array
+      const data = JSON.parse(msg.data);
+      if (Array.isArray(data)) {
+        data.forEach(handleEvent);
+      } else {
+        handleEvent(data);
+      }
     }
   };
+  // Entity updates are sent as binary frames once the server knows we decode them
+  sendCommand("SetProtocol", { binary: true });
 
   loadScene(sceneFile);
   renderer.setSize(window.innerWidth, window.innerHeight);
@@ -145,7 +232,6 @@ connect().then((socket) => {
     let delta = clock.getDelta();
     time += delta;
     updateAnimations(delta);
-    sendCommand("Update", { simSpeed: simSpeed });
     updateControls();
     renderer.render(scene, camera);
   });
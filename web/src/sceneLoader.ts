@@ -5,6 +5,15 @@ import { sendCommand } from "./websocket_api";
 
 function loadScene(file: string) {
   $.getJSON(file, (data) => {
+    // Consecutive entities are created on the server in one batch, which is
+    // sent before the next command so the scene keeps its order
+    let entities: any[] = [];
+    const flush = () => {
+      if (entities.length > 0) {
+        sendCommand("CreateEntities", { entities: entities });
+        entities = [];
+      }
+    };
     data.forEach((command: any) => {
       switch (command.command) {
         case "SetScene":
@@ -17,11 +26,16 @@ function loadScene(file: string) {
             addMesh(command.params);
           }
           break;
+        case "CreateEntity":
+          entities.push(command.params);
+          break;
         default:
+          flush();
           sendCommand(command.command, command.params);
           break;
       }
     });
+    flush();
   });
 }
 